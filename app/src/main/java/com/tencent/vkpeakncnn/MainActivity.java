@@ -58,6 +58,8 @@ public class MainActivity extends Activity
     private TextView textviewINT8mm;
     private TextView textviewBF16dp;
     private TextView textviewBF16mm;
+    private TextView textviewFP8E4M3mm;
+    private TextView textviewFP8E5M2mm;
 
     private float fp32;
     private float fp32v4;
@@ -74,6 +76,8 @@ public class MainActivity extends Activity
     private float int8mm;
     private float bf16dp;
     private float bf16mm;
+    private float fp8e4m3mm;
+    private float fp8e5m2mm;
 
     /** Called when the activity is first created. */
     @Override
@@ -100,6 +104,8 @@ public class MainActivity extends Activity
         textviewAPI.setText("  " + vkpeakncnn.GetApiVersion());
         textviewDriver.setText("  " + vkpeakncnn.GetDriverVersion());
 
+        vkpeakncnn.SetCacheDir(getCacheDir().getAbsolutePath());
+
         spinnerMacs = (Spinner) findViewById(R.id.spinnerMacs);
         spinnerCounts = (Spinner) findViewById(R.id.spinnerCounts);
         spinnerLoops = (Spinner) findViewById(R.id.spinnerLoops);
@@ -119,6 +125,8 @@ public class MainActivity extends Activity
         textviewINT8mm = (TextView) findViewById(R.id.textviewINT8mm);
         textviewBF16dp = (TextView) findViewById(R.id.textviewBF16dp);
         textviewBF16mm = (TextView) findViewById(R.id.textviewBF16mm);
+        textviewFP8E4M3mm = (TextView) findViewById(R.id.textviewFP8E4M3mm);
+        textviewFP8E5M2mm = (TextView) findViewById(R.id.textviewFP8E5M2mm);
 
         // apply default settings
         spinnerMacs.setSelection(1);
@@ -139,67 +147,68 @@ public class MainActivity extends Activity
                         int count_mb = Integer.parseInt(spinnerCounts.getSelectedItem().toString());
                         int cmd_loop = Integer.parseInt(spinnerLoops.getSelectedItem().toString());
 
-                        sleep(500);
-                        fp32 = vkpeakncnn.Run(loop, count_mb, cmd_loop, 0, 0, 1);
-                        textviewFP32.post(new Runnable() { public void run() { textviewFP32.setText(textHelper(fp32)); } });
-
-                        sleep(500);
-                        fp32v4 = vkpeakncnn.Run(loop, count_mb, cmd_loop, 0, 0, 4);
-                        textviewFP32v4.post(new Runnable() { public void run() { textviewFP32v4.setText(textHelper(fp32v4)); } });
-
-                        sleep(500);
-                        fp16 = vkpeakncnn.Run(loop, count_mb, cmd_loop, 0, 1, 1);
-                        textviewFP16.post(new Runnable() { public void run() { textviewFP16.setText(textHelper(fp16)); } });
-
-                        sleep(500);
-                        fp16v4 = vkpeakncnn.Run(loop, count_mb, cmd_loop, 0, 1, 4);
-                        textviewFP16v4.post(new Runnable() { public void run() { textviewFP16v4.setText(textHelper(fp16v4)); } });
-
-                        sleep(500);
-                        fp16mm = vkpeakncnn.Run(loop, count_mb, cmd_loop, 1, 1, 256);
-                        textviewFP16mm.post(new Runnable() { public void run() { textviewFP16mm.setText(textHelper(fp16mm)); } });
-
-                        sleep(500);
-                        fp64 = vkpeakncnn.Run(loop, count_mb, cmd_loop, 2, 2, 1);
-                        textviewFP64.post(new Runnable() { public void run() { textviewFP64.setText(textHelper(fp64)); } });
-
-                        sleep(500);
-                        fp64v4 = vkpeakncnn.Run(loop, count_mb, cmd_loop, 2, 2, 4);
-                        textviewFP64v4.post(new Runnable() { public void run() { textviewFP64v4.setText(textHelper(fp64v4)); } });
-
-                        sleep(500);
-                        int32 = vkpeakncnn.Run(loop, count_mb, cmd_loop, 3, 3, 1);
-                        textviewINT32.post(new Runnable() { public void run() { textviewINT32.setText(textHelper(int32)); } });
-
-                        sleep(500);
-                        int32v4 = vkpeakncnn.Run(loop, count_mb, cmd_loop, 3, 3, 4);
-                        textviewINT32v4.post(new Runnable() { public void run() { textviewINT32v4.setText(textHelper(int32v4)); } });
-
-                        sleep(500);
-                        int16 = vkpeakncnn.Run(loop, count_mb, cmd_loop, 3, 4, 1);
-                        textviewINT16.post(new Runnable() { public void run() { textviewINT16.setText(textHelper(int16)); } });
-
-                        sleep(500);
-                        int16v4 = vkpeakncnn.Run(loop, count_mb, cmd_loop, 3, 4, 4);
-                        textviewINT16v4.post(new Runnable() { public void run() { textviewINT16v4.setText(textHelper(int16v4)); } });
-
-                        sleep(500);
-                        int8dp = vkpeakncnn.Run(loop, count_mb, cmd_loop, 3, 5, 4);
-                        textviewINT8dp.post(new Runnable() { public void run() { textviewINT8dp.setText(textHelper(int8dp)); } });
-
-                        sleep(500);
-                        int8mm = vkpeakncnn.Run(loop, count_mb, cmd_loop, 3, 5, 256);
-                        textviewINT8mm.post(new Runnable() { public void run() { textviewINT8mm.setText(textHelper(int8mm)); } });
-
-                        sleep(500);
-                        bf16dp = vkpeakncnn.Run(loop, count_mb, cmd_loop, 0, 6, 4);
-                        textviewBF16dp.post(new Runnable() { public void run() { textviewBF16dp.setText(textHelper(bf16dp)); } });
-
-                        sleep(500);
-                        bf16mm = vkpeakncnn.Run(loop, count_mb, cmd_loop, 0, 6, 256);
-                        textviewBF16mm.post(new Runnable() { public void run() { textviewBF16mm.setText(textHelper(bf16mm)); } });
+                        // storage arithmetic packing, all shaders are compiled up front in one native call
+                        int[] configs = {
+                            0, 0, 1,
+                            0, 0, 4,
+                            0, 1, 1,
+                            0, 1, 4,
+                            1, 1, 256,
+                            2, 2, 1,
+                            2, 2, 4,
+                            3, 3, 1,
+                            3, 3, 4,
+                            3, 4, 1,
+                            3, 4, 4,
+                            3, 5, 4,
+                            3, 5, 256,
+                            0, 6, 4,
+                            0, 6, 256,
+                            0, 7, 256,
+                            0, 8, 256
+                        };
+
+                        float[] results = vkpeakncnn.RunSweep(loop, count_mb, cmd_loop, configs);
+
+                        fp32 = results[0 * 7];
+                        fp32v4 = results[1 * 7];
+                        fp16 = results[2 * 7];
+                        fp16v4 = results[3 * 7];
+                        fp16mm = results[4 * 7];
+                        fp64 = results[5 * 7];
+                        fp64v4 = results[6 * 7];
+                        int32 = results[7 * 7];
+                        int32v4 = results[8 * 7];
+                        int16 = results[9 * 7];
+                        int16v4 = results[10 * 7];
+                        int8dp = results[11 * 7];
+                        int8mm = results[12 * 7];
+                        bf16dp = results[13 * 7];
+                        bf16mm = results[14 * 7];
+                        fp8e4m3mm = results[15 * 7];
+                        fp8e5m2mm = results[16 * 7];
+
+                        textviewFP32.post(new Runnable() { public void run() {
+                            textviewFP32.setText(textHelper(fp32));
+                            textviewFP32v4.setText(textHelper(fp32v4));
+                            textviewFP16.setText(textHelper(fp16));
+                            textviewFP16v4.setText(textHelper(fp16v4));
+                            textviewFP16mm.setText(textHelper(fp16mm));
+                            textviewFP64.setText(textHelper(fp64));
+                            textviewFP64v4.setText(textHelper(fp64v4));
+                            textviewINT32.setText(textHelper(int32));
+                            textviewINT32v4.setText(textHelper(int32v4));
+                            textviewINT16.setText(textHelper(int16));
+                            textviewINT16v4.setText(textHelper(int16v4));
+                            textviewINT8dp.setText(textHelper(int8dp));
+                            textviewINT8mm.setText(textHelper(int8mm));
+                            textviewBF16dp.setText(textHelper(bf16dp));
+                            textviewBF16mm.setText(textHelper(bf16mm));
+                            textviewFP8E4M3mm.setText(textHelper(fp8e4m3mm));
+                            textviewFP8E5M2mm.setText(textHelper(fp8e5m2mm));
+                        } });
 
-                        textviewBF16mm.post(new Runnable() { public void run() {
+                        textviewFP8E5M2mm.post(new Runnable() { public void run() {
                             getWindow().clearFlags(WindowManager.LayoutParams.FLAG_NOT_TOUCHABLE);
                             getWindow().clearFlags(WindowManager.LayoutParams.FLAG_KEEP_SCREEN_ON);
                         } });
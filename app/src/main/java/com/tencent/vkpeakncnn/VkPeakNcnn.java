@@ -22,16 +22,132 @@ public class VkPeakNcnn
 
     public native String GetNcnnVersion();
 
+    // number of vulkan devices, SetDevice selects the one the getters and Run* use
+    public native int GetGpuCount();
+    public native void SetDevice(int device_index);
+
     public native String GetVkDevice();
     public native String GetApiVersion();
     public native String GetDriverVersion();
 
+    // cache_dir        = writable directory for compiled spirv, app cache dir
+    public native void SetCacheDir(String cache_dir);
+
+    // loop_type        = 0/1           = specialization constant push constant
+    public native void SetLoopType(int loop_type);
+
+    // dispatch_count   = dispatches per submit, default 1
+    public native void SetDispatchCount(int dispatch_count);
+
+    // queue_count      = compute queues every dispatch is split over, default 1
+    public native void SetQueueCount(int queue_count);
+
+    // cv_threshold     = sample until the standard error is below this fraction of the mean, 0 = fixed cmd_loop samples
+    // time_budget_ms   = sampling time budget per test
+    public native void SetSampler(float cv_threshold, int time_budget_ms);
+
+    // returns median p10 p90 max cv sample_count of the last run
+    // the last run results are kept per thread, call GetLastStats GetSustained and GetSustainedSamples
+    // on the same thread as the Run call, other threads get empty results
+    public native float[] GetLastStats();
+
+    // local_size_x     = workgroup size of the following runs, 0 = built-in size of each kernel
+    public native void SetLocalSize(int local_size_x);
+
+    // duration_ms      = keep every following run busy this long and record the throughput over time, 0 = off
+    // the runs then return the steady state throughput
+    public native void SetSustained(int duration_ms);
+
+    // returns peak steady steady_ratio throttle_ms sample_count of the last sustained run, throttle_ms -1 if never
+    // on the thread of the Run call only
+    public native float[] GetSustained();
+
+    // returns the samples of the last sustained run as ms since start and throughput pairs, oldest first
+    // on the thread of the Run call only
+    public native float[] GetSustainedSamples();
+
     // device_id        = 0
     // storage_type     = 0/1/2/3/4/5/6 = fp32 fp16 fp64 int32 int16 int8 bf16
-    // arithmetic_type  = 0/1/2/3/4/5/6 = fp32 fp16 fp64 int32 int16 int8 bf16
-    // packing_type     = 1/4/256       = scalar vec4/dotprod matrix
+    // arithmetic_type  = 0/1/2/3/4/5/6/7/8 = fp32 fp16 fp64 int32 int16 int8 bf16 fp8e4m3 fp8e5m2
+    // packing_type     = 1/4/256       = scalar vec4/dotprod matrix, fp8 is matrix only
     public native float Run(int loop, int count_mb, int cmd_loop, int storage_type, int arithmetic_type, int packing_type);
 
+    // unroll           = statements per loop, 16 for the default kernels
+    // chains           = 1 to unroll independent accumulators, packing_type 256 is not supported
+    public native float RunCustom(int loop, int count_mb, int cmd_loop, int storage_type, int arithmetic_type, int packing_type, int unroll, int chains);
+
+    // chains           = 1/2/4/8/16 independent accumulators, packing_type 256 is not supported
+    public native float RunIlp(int loop, int count_mb, int cmd_loop, int storage_type, int arithmetic_type, int packing_type, int chains);
+
+    // configs          = storage_type arithmetic_type packing_type of every test, 3 ints each
+    // returns gflops median p10 p90 max cv sample_count of every test, 7 floats each
+    public native float[] RunSweep(int loop, int count_mb, int cmd_loop, int[] configs);
+
+    // returns the cooperative matrix configurations the driver advertises, shape and a*b+c=result types
+    public native String[] GetMatrixConfigs();
+
+    // config_index     = index into GetMatrixConfigs
+    // returns GOPS of a kernel generated for the configuration
+    public native float RunMatrix(int loop, int count_mb, int cmd_loop, int config_index);
+
+    // rows cols        = 1 to 4, a rows x cols grid of accumulators per subgroup
+    // returns GOPS
+    public native float RunMatrixBlocked(int loop, int count_mb, int cmd_loop, int config_index, int rows, int cols);
+
+    // signedness_type  = 0/1/2         = signed unsigned mixed
+    // saturating       = 0/1           = wrapping add saturating accumulate
+    // packing_type     = 4/8           = int8 int4
+    // returns GIOPS
+    public native float RunDot(int loop, int count_mb, int cmd_loop, int signedness_type, int saturating, int packing_type);
+
+    // returns true if the driver reports the packed int8 dot product as accelerated
+    public native boolean IsDotAccelerated(int signedness_type, int saturating);
+
+    // gemm_type        = 0/1/2         = sgemm hgemm fp16 matrix
+    // returns GFLOPS of a M x K times K x N gemm
+    public native float RunGemm(int cmd_loop, int gemm_type, int M, int N, int K);
+
+    // storage_type     = 0/1           = fp32 fp16
+    // access_type      = 0/1/2/3       = read write copy triad
+    // packing_type     = 1/4           = scalar vec4
+    // returns GB/s
+    public native float RunBandwidth(int loop, int count_mb, int cmd_loop, int storage_type, int access_type, int packing_type);
+
+    // access_type      = 0/1           = load store
+    // stride           = 1/2/3/...     = element stride between neighbouring invocations
+    // returns GB/s
+    public native float RunShared(int loop, int count_mb, int cmd_loop, int access_type, int stride);
+
+    // arithmetic_type  = 0/1/3         = fp32 fp16 int32
+    // op_type          = 0/1/2/3/4     = add shuffle shufflexor broadcast ballot
+    // returns G lane-ops/s
+    public native float RunSubgroup(int loop, int count_mb, int cmd_loop, int arithmetic_type, int op_type);
+
+    // arithmetic_type  = 0/1           = fp32 fp16
+    // packing_type     = 1/4           = scalar vec4
+    // func_type        = 0/1/2/3/4     = exp log sin rsqrt div
+    // returns Gops/s
+    public native float RunSfu(int loop, int count_mb, int cmd_loop, int arithmetic_type, int packing_type, int func_type);
+
+    // footprint_kb     = size of the pointer chase chain in KB
+    // walker_type      = 0/1           = thread subgroup
+    // returns ns per access
+    public native float RunLatency(int loop, int cmd_loop, int footprint_kb, int walker_type);
+
+    // thread_count     = 1 = single core, 0 = all cpu cores
+    // arithmetic_type  = 0/1/5         = fp32 fp16 int8
+    // packing_type     = 4/256         = simd/dotprod matrix
+    public native float RunCpu(int loop, int cmd_loop, int thread_count, int arithmetic_type, int packing_type);
+    public native String GetCpuKernelName(int arithmetic_type, int packing_type);
+
+    // cpu clusters, the fastest first, max freq in MHz
+    public native int GetCpuClusterCount();
+    public native int GetCpuClusterCoreCount(int cluster_index);
+    public native int GetCpuClusterMaxFreq(int cluster_index);
+
+    // thread_count     = threads pinned one per core of the cluster, 0 = all cores of the cluster
+    public native float RunCpuCluster(int loop, int cmd_loop, int cluster_index, int thread_count, int arithmetic_type, int packing_type);
+
     static {
         System.loadLibrary("vkpeakncnn");
     }
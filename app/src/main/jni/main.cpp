@@ -0,0 +1,1239 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+#include <sys/stat.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+// ncnn
+#include <cpu.h>
+#include <gpu.h>
+#include <platform.h>
+
+#include "vkpeak.h"
+#include "vkpeak_runner.h"
+
+static const char* const modes[] = {"peak", "bandwidth", "shared", "subgroup", "sfu", "latency", "unroll", "multi", "queue", "cpu", "cluster", "sustained", "wgsize", "ilp", "depth", "matrix", "block", "dot", "gemm"};
+
+static bool g_print_stats = false;
+
+// distribution of the samples behind a result, only with the sampler
+static void print_stats(const vkpeak_stats& stats)
+{
+    if (!g_print_stats)
+        return;
+
+    if (stats.sample_count == 0)
+        return;
+
+    fprintf(stdout, "  p10 %.2f median %.2f p90 %.2f n=%d", stats.p10, stats.median, stats.p90, stats.sample_count);
+}
+
+static void print_stats()
+{
+    vkpeak_stats stats;
+    vkpeak_get_last_stats(&stats);
+
+    print_stats(stats);
+}
+
+struct vkpeak_config
+{
+    const char* name;
+    const char* unit;
+    int storage_type;
+    int arithmetic_type;
+    int packing_type;
+};
+
+// same order as the android app
+static const vkpeak_config configs[] = {
+    {"fp32-scalar", "GFLOPS", 0, 0, 1},
+    {"fp32-vec4", "GFLOPS", 0, 0, 4},
+    {"fp16-scalar", "GFLOPS", 0, 1, 1},
+    {"fp16-vec4", "GFLOPS", 0, 1, 4},
+    {"fp16-matrix", "GFLOPS", 1, 1, 256},
+    {"fp64-scalar", "GFLOPS", 2, 2, 1},
+    {"fp64-vec4", "GFLOPS", 2, 2, 4},
+    {"int32-scalar", "GIOPS", 3, 3, 1},
+    {"int32-vec4", "GIOPS", 3, 3, 4},
+    {"int16-scalar", "GIOPS", 3, 4, 1},
+    {"int16-vec4", "GIOPS", 3, 4, 4},
+    {"int8-dotprod", "GIOPS", 3, 5, 4},
+    {"int8-matrix", "GIOPS", 3, 5, 256},
+    {"bf16-dotprod", "GFLOPS", 0, 6, 4},
+    {"bf16-matrix", "GFLOPS", 0, 6, 256},
+    {"e4m3-matrix", "GFLOPS", 0, 7, 256},
+    {"e5m2-matrix", "GFLOPS", 0, 8, 256},
+};
+
+struct vkpeak_bandwidth_config
+{
+    const char* name;
+    int storage_type;
+    int packing_type;
+};
+
+static const vkpeak_bandwidth_config bandwidth_configs[] = {
+    {"fp32-scalar", 0, 1},
+    {"fp32-vec4", 0, 4},
+    {"fp16-scalar", 1, 1},
+    {"fp16-vec4", 1, 4},
+};
+
+static const char* const access_names[] = {"read", "write", "copy", "triad"};
+
+// odd strides are conflict free on power-of-two bank counts
+static const int shared_strides[] = {1, 2, 3, 4, 8, 16, 17, 32, 33};
+
+static const char* const shared_access_names[] = {"load", "store"};
+
+struct vkpeak_subgroup_config
+{
+    const char* name;
+    const char* unit;
+    int storage_type;
+    int arithmetic_type;
+};
+
+static const vkpeak_subgroup_config subgroup_configs[] = {
+    {"fp32", "GFLOPS", 0, 0},
+    {"fp16", "GFLOPS", 0, 1},
+    {"int32", "GIOPS", 3, 3},
+};
+
+static const char* const subgroup_op_names[] = {"add", "shuffle", "shufflexor", "broadcast", "ballot"};
+
+struct vkpeak_sfu_config
+{
+    const char* name;
+    int arithmetic_type;
+    int packing_type;
+};
+
+static const vkpeak_sfu_config sfu_configs[] = {
+    {"fp32-scalar", 0, 1},
+    {"fp32-vec4", 0, 4},
+    {"fp16-scalar", 1, 1},
+    {"fp16-vec4", 1, 4},
+};
+
+static const char* const sfu_func_names[] = {"exp", "log", "sin", "rsqrt", "div"};
+
+static void print_usage(const char* argv0)
+{
+    fprintf(stderr, "Usage: %s [options]\n", argv0);
+    fprintf(stderr, "  -m mode              peak / bandwidth / shared / subgroup / sfu / latency / unroll / multi / queue / cpu / cluster / sustained / wgsize / ilp / depth / matrix / block / dot / gemm, default peak\n");
+    fprintf(stderr, "  -l loop              MACs(16x) per invocation, default 20\n");
+    fprintf(stderr, "  -c count_mb          max work buffer size in MB, default 5, 512 for bandwidth and latency\n");
+    fprintf(stderr, "  -r cmd_loop          timed submits per test, default 5\n");
+    fprintf(stderr, "  -s storage_type      0/1/2/3/4/5 = fp32 fp16 fp64 int32 int16 int8\n");
+    fprintf(stderr, "  -a arithmetic_type   0/1/2/3/4/5/6/7/8 = fp32 fp16 fp64 int32 int16 int8 bf16 fp8e4m3 fp8e5m2\n");
+    fprintf(stderr, "  -p packing_type      1/4/256 = scalar vec4/dotprod matrix\n");
+    fprintf(stderr, "  -d device_index      vulkan device, default the ncnn default device\n");
+    fprintf(stderr, "  -t timing_type       0/1 = gpu timestamp host, default 0\n");
+    fprintf(stderr, "  -u loop_type         0/1 = specialization constant push constant, default 0\n");
+    fprintf(stderr, "  -b dispatch_count    dispatches per submit, default 1\n");
+    fprintf(stderr, "  -q queue_count       split every alu dispatch over this many compute queues, default 1\n");
+    fprintf(stderr, "  -v cv_threshold      sample until the standard error is below this fraction of the mean, e.g. 0.01, default 0 = fixed cmd_loop samples\n");
+    fprintf(stderr, "  -g time_budget_ms    sampling time budget per test, default 10000\n");
+    fprintf(stderr, "  -x local_size_x      workgroup size of the kernels, default 0 = built-in size of each kernel\n");
+    fprintf(stderr, "  -w duration_s        sustained run length in seconds, default 60\n");
+    fprintf(stderr, "  -k cache_dir         compiled spirv cache, default $XDG_CACHE_HOME/vkpeak or ~/.cache/vkpeak, empty to disable\n");
+    fprintf(stderr, "run all the tests of the android app if none of -s -a -p is given\n");
+    fprintf(stderr, "queue runs one peak test, default fp32-vec4, on 1 to all compute queues of the device\n");
+    fprintf(stderr, "sustained runs one peak test, default fp32-vec4, for duration_s and prints the throughput over time\n");
+    fprintf(stderr, "wgsize runs every peak test on power of two workgroup sizes from the subgroup size to the device max\n");
+    fprintf(stderr, "ilp runs every non-matrix peak test with 1 2 4 8 16 independent accumulator chains\n");
+    fprintf(stderr, "depth runs every non-matrix peak test with 8 16 32 64 statements per loop and the same work per invocation\n");
+    fprintf(stderr, "matrix runs every cooperative matrix shape and type combination the driver advertises\n");
+    fprintf(stderr, "block runs the fp16 int8 bf16 matrix configurations with 1 2 4 x 1 2 4 accumulator grids per subgroup\n");
+    fprintf(stderr, "dot runs the signed unsigned and mixed packed int8 and int4 dot products, wrapping and saturating\n");
+    fprintf(stderr, "gemm runs sgemm hgemm and fp16 matrix gemm from decode to prefill sizes as percent of the matching peak test\n");
+    fprintf(stderr, "multi runs one peak test, default fp32-vec4, on every device alone and then on all devices at once\n");
+}
+
+static void run_peak(int loop, int count_mb, int cmd_loop, int storage_type, int arithmetic_type, int packing_type)
+{
+    if (storage_type != -1)
+    {
+        double gflops = vkpeak(loop, count_mb, cmd_loop, storage_type, arithmetic_type, packing_type);
+
+        fprintf(stdout, "storage=%d arithmetic=%d packing=%d = %.2f GFLOPS", storage_type, arithmetic_type, packing_type, gflops);
+        print_stats();
+        fprintf(stdout, "\n");
+        return;
+    }
+
+    // one sweep compiles the shaders of all tests in parallel before timing the first
+    const int config_count = sizeof(configs) / sizeof(configs[0]);
+
+    std::vector<int> storage_types(config_count);
+    std::vector<int> arithmetic_types(config_count);
+    std::vector<int> packing_types(config_count);
+    for (int i = 0; i < config_count; i++)
+    {
+        storage_types[i] = configs[i].storage_type;
+        arithmetic_types[i] = configs[i].arithmetic_type;
+        packing_types[i] = configs[i].packing_type;
+    }
+
+    std::vector<double> results(config_count);
+    std::vector<vkpeak_stats> stats(config_count);
+    vkpeak_sweep(loop, count_mb, cmd_loop, config_count, storage_types.data(), arithmetic_types.data(), packing_types.data(), results.data(), stats.data());
+
+    for (int i = 0; i < config_count; i++)
+    {
+        const vkpeak_config& cfg = configs[i];
+
+        fprintf(stdout, "%-12s = %.2f %s", cfg.name, results[i], cfg.unit);
+        print_stats(stats[i]);
+        fprintf(stdout, "\n");
+    }
+}
+
+// the same peak tests with the loop count as specialization constant and as push constant
+// a large gap means the driver compiler gains a lot from knowing the trip count
+static void run_unroll(int loop, int count_mb, int cmd_loop)
+{
+    const int config_count = sizeof(configs) / sizeof(configs[0]);
+    for (int i = 0; i < config_count; i++)
+    {
+        const vkpeak_config& cfg = configs[i];
+
+        vkpeak_set_loop_type(0);
+        double gflops_spec = vkpeak(loop, count_mb, cmd_loop, cfg.storage_type, cfg.arithmetic_type, cfg.packing_type);
+
+        vkpeak_set_loop_type(1);
+        double gflops_push = vkpeak(loop, count_mb, cmd_loop, cfg.storage_type, cfg.arithmetic_type, cfg.packing_type);
+
+        fprintf(stdout, "%-12s = %.2f / %.2f %s", cfg.name, gflops_spec, gflops_push, cfg.unit);
+        if (gflops_spec > 0 && gflops_push > 0)
+            fprintf(stdout, "  push/spec = %.2f", gflops_push / gflops_spec);
+        fprintf(stdout, "\n");
+        fflush(stdout);
+    }
+
+    vkpeak_set_loop_type(0);
+}
+
+struct vkpeak_multi_task
+{
+    int device_index;
+    int loop;
+    int count_mb;
+    int cmd_loop;
+    int storage_type;
+    int arithmetic_type;
+    int packing_type;
+
+    double gflops;
+};
+
+static void* multi_worker(void* args)
+{
+    vkpeak_multi_task* task = (vkpeak_multi_task*)args;
+
+    vkpeak_set_device_index(task->device_index);
+
+    task->gflops = vkpeak(task->loop, task->count_mb, task->cmd_loop, task->storage_type, task->arithmetic_type, task->packing_type);
+
+    return 0;
+}
+
+// the same test on every device from its own host thread, concurrent throughput below the sum of
+// the solo runs points at shared host, driver or pcie limits
+static void run_multi(int loop, int count_mb, int cmd_loop, int storage_type, int arithmetic_type, int packing_type)
+{
+    if (storage_type == -1)
+    {
+        // fp32-vec4
+        storage_type = 0;
+        arithmetic_type = 0;
+        packing_type = 4;
+    }
+
+    const int device_count = vkpeak_get_device_count();
+
+    std::vector<vkpeak_multi_task> tasks(device_count);
+    for (int i = 0; i < device_count; i++)
+    {
+        vkpeak_multi_task& task = tasks[i];
+        task.device_index = i;
+        task.loop = loop;
+        task.count_mb = count_mb;
+        task.cmd_loop = cmd_loop;
+        task.storage_type = storage_type;
+        task.arithmetic_type = arithmetic_type;
+        task.packing_type = packing_type;
+        task.gflops = 0;
+    }
+
+    fprintf(stdout, "storage=%d arithmetic=%d packing=%d\n", storage_type, arithmetic_type, packing_type);
+
+    // one device at a time
+    double solo_sum = 0;
+    for (int i = 0; i < device_count; i++)
+    {
+        ncnn::Thread thread(multi_worker, &tasks[i]);
+        thread.join();
+
+        char name[64];
+        sprintf(name, "gpu%d-solo", i);
+
+        fprintf(stdout, "%-18s = %.2f GFLOPS\n", name, tasks[i].gflops);
+        fflush(stdout);
+
+        solo_sum += tasks[i].gflops;
+    }
+
+    // all devices at once
+    std::vector<ncnn::Thread*> threads(device_count);
+    for (int i = 0; i < device_count; i++)
+    {
+        threads[i] = new ncnn::Thread(multi_worker, &tasks[i]);
+    }
+    for (int i = 0; i < device_count; i++)
+    {
+        threads[i]->join();
+        delete threads[i];
+    }
+
+    double aggregate = 0;
+    for (int i = 0; i < device_count; i++)
+    {
+        char name[64];
+        sprintf(name, "gpu%d-concurrent", i);
+
+        fprintf(stdout, "%-18s = %.2f GFLOPS\n", name, tasks[i].gflops);
+
+        aggregate += tasks[i].gflops;
+    }
+
+    fprintf(stdout, "%-18s = %.2f GFLOPS", "aggregate", aggregate);
+    if (solo_sum > 0)
+        fprintf(stdout, "  %.1f%% of solo sum", aggregate / solo_sum * 100);
+    fprintf(stdout, "\n");
+}
+
+// every peak test on workgroup sizes from the subgroup size to the device max, the curve shows
+// how occupancy moves the peak and which size an ncnn layer on this device should use
+static void run_wgsize(int loop, int count_mb, int cmd_loop)
+{
+    ncnn::VulkanDevice* vkdev = vkpeak_get_device();
+
+    const int subgroup_size = std::max(1, (int)vkdev->info.subgroup_size());
+    const int max_local_size = std::min((int)vkdev->info.max_workgroup_size_x(), (int)vkdev->info.max_workgroup_invocations());
+
+    std::vector<int> local_sizes;
+    for (int local_size_x = subgroup_size; local_size_x <= max_local_size; local_size_x *= 2)
+    {
+        local_sizes.push_back(local_size_x);
+    }
+
+    const int config_count = sizeof(configs) / sizeof(configs[0]);
+    for (int i = 0; i < config_count; i++)
+    {
+        const vkpeak_config& cfg = configs[i];
+
+        fprintf(stdout, "%-12s =", cfg.name);
+
+        int best_local_size = 0;
+        double best_gflops = 0;
+        for (size_t j = 0; j < local_sizes.size(); j++)
+        {
+            vkpeak_set_local_size(local_sizes[j]);
+
+            double gflops = vkpeak(loop, count_mb, cmd_loop, cfg.storage_type, cfg.arithmetic_type, cfg.packing_type);
+
+            fprintf(stdout, " %d:%.2f", local_sizes[j], gflops);
+            fflush(stdout);
+
+            if (gflops > best_gflops)
+            {
+                best_gflops = gflops;
+                best_local_size = local_sizes[j];
+            }
+
+            // not supported on this device
+            if (gflops == 0)
+                break;
+        }
+
+        if (best_local_size > 0)
+            fprintf(stdout, "  best %d = %.2f %s", best_local_size, best_gflops, cfg.unit);
+        fprintf(stdout, "\n");
+    }
+
+    vkpeak_set_local_size(0);
+}
+
+// every non-matrix peak test with 1 to 16 independent accumulator chains
+// the chain count where the throughput saturates is the number of fma in flight the alu needs
+static void run_ilp(int loop, int count_mb, int cmd_loop)
+{
+    static const int chain_counts[] = {1, 2, 4, 8, 16};
+    const int chain_count_count = sizeof(chain_counts) / sizeof(chain_counts[0]);
+
+    const int config_count = sizeof(configs) / sizeof(configs[0]);
+    for (int i = 0; i < config_count; i++)
+    {
+        const vkpeak_config& cfg = configs[i];
+
+        if (cfg.packing_type == 256)
+            continue;
+
+        fprintf(stdout, "%-12s =", cfg.name);
+
+        double gflops[chain_count_count];
+        double best_gflops = 0;
+        for (int j = 0; j < chain_count_count; j++)
+        {
+            gflops[j] = vkpeak_ilp(loop, count_mb, cmd_loop, cfg.storage_type, cfg.arithmetic_type, cfg.packing_type, chain_counts[j]);
+
+            fprintf(stdout, " %d:%.2f", chain_counts[j], gflops[j]);
+            fflush(stdout);
+
+            best_gflops = std::max(best_gflops, gflops[j]);
+
+            // not supported on this device
+            if (gflops[j] == 0)
+                break;
+        }
+
+        // the fewest chains within 5% of the best
+        for (int j = 0; j < chain_count_count && best_gflops > 0; j++)
+        {
+            if (gflops[j] >= best_gflops * 0.95)
+            {
+                fprintf(stdout, "  saturates at %d = %.2f %s", chain_counts[j], best_gflops, cfg.unit);
+                break;
+            }
+        }
+        fprintf(stdout, "\n");
+    }
+}
+
+// every non-matrix peak test with 8 to 64 statements per loop on two chains, loop scaled to keep the work per invocation
+// a drop at 8 is loop overhead, a drop at 64 is the instruction cache
+static void run_depth(int loop, int count_mb, int cmd_loop)
+{
+    static const int unrolls[] = {8, 16, 32, 64};
+    const int unroll_count = sizeof(unrolls) / sizeof(unrolls[0]);
+
+    const int config_count = sizeof(configs) / sizeof(configs[0]);
+    for (int i = 0; i < config_count; i++)
+    {
+        const vkpeak_config& cfg = configs[i];
+
+        if (cfg.packing_type == 256)
+            continue;
+
+        fprintf(stdout, "%-12s =", cfg.name);
+
+        for (int j = 0; j < unroll_count; j++)
+        {
+            const int unroll_loop = std::max(loop * 16 / unrolls[j], 1);
+
+            double gflops = vkpeak_custom(unroll_loop, count_mb, cmd_loop, cfg.storage_type, cfg.arithmetic_type, cfg.packing_type, unrolls[j], 2);
+
+            fprintf(stdout, " %d:%.2f", unrolls[j], gflops);
+            fflush(stdout);
+
+            // not supported on this device
+            if (gflops == 0)
+                break;
+        }
+
+        fprintf(stdout, " %s\n", cfg.unit);
+    }
+}
+
+// every advertised cooperative matrix configuration with a kernel generated for it
+static void run_matrix(int loop, int count_mb, int cmd_loop)
+{
+    const int config_count = vkpeak_get_matrix_config_count();
+    if (config_count == 0)
+    {
+        fprintf(stdout, "no cooperative matrix support\n");
+        return;
+    }
+
+    fprintf(stdout, "%-12s %-5s %-5s %-5s %-5s %-3s = TOPS\n", "MxNxK", "A", "B", "C", "R", "sat");
+
+    for (int i = 0; i < config_count; i++)
+    {
+        vkpeak_matrix_config config;
+        vkpeak_get_matrix_config(i, &config);
+
+        char shape[64];
+        sprintf(shape, "%dx%dx%d", config.M, config.N, config.K);
+
+        fprintf(stdout, "%-12s %-5s %-5s %-5s %-5s %-3s = ", shape, vkpeak_matrix_type_name(config.a_type), vkpeak_matrix_type_name(config.b_type),
+                vkpeak_matrix_type_name(config.c_type), vkpeak_matrix_type_name(config.result_type), config.saturating ? "yes" : "no");
+        fflush(stdout);
+
+        double gops = vkpeak_matrix(loop, count_mb, cmd_loop, i);
+
+        // the statistics in TOPS as well
+        vkpeak_stats stats;
+        vkpeak_get_last_stats(&stats);
+        stats.median /= 1000;
+        stats.p10 /= 1000;
+        stats.p90 /= 1000;
+        stats.max /= 1000;
+
+        fprintf(stdout, "%.2f", gops / 1000);
+        print_stats(stats);
+        fprintf(stdout, "\n");
+        fflush(stdout);
+    }
+}
+
+// the fp16 int8 bf16 matrix configurations with a grid of accumulators per subgroup sharing the a and b fragments
+// the best grid is what a gemm microkernel can get out of the matrix units
+static void run_block(int loop, int count_mb, int cmd_loop)
+{
+    static const int grid_sizes[] = {1, 2, 4};
+    const int grid_size_count = sizeof(grid_sizes) / sizeof(grid_sizes[0]);
+
+    const int config_count = vkpeak_get_matrix_config_count();
+    if (config_count == 0)
+    {
+        fprintf(stdout, "no cooperative matrix support\n");
+        return;
+    }
+
+    for (int i = 0; i < config_count; i++)
+    {
+        vkpeak_matrix_config config;
+        vkpeak_get_matrix_config(i, &config);
+
+        const char* a_type = vkpeak_matrix_type_name(config.a_type);
+        if (strcmp(a_type, "fp16") != 0 && strcmp(a_type, "s8") != 0 && strcmp(a_type, "bf16") != 0)
+            continue;
+
+        char name[64];
+        sprintf(name, "%dx%dx%d-%s-%s", config.M, config.N, config.K, a_type, vkpeak_matrix_type_name(config.c_type));
+
+        fprintf(stdout, "%-22s =", name);
+
+        double best_tops = 0;
+        int best_rows = 0;
+        int best_cols = 0;
+        for (int r = 0; r < grid_size_count; r++)
+        {
+            for (int c = 0; c < grid_size_count; c++)
+            {
+                double tops = vkpeak_matrix_blocked(loop, count_mb, cmd_loop, i, grid_sizes[r], grid_sizes[c]) / 1000;
+
+                fprintf(stdout, " %dx%d:%.2f", grid_sizes[r], grid_sizes[c], tops);
+                fflush(stdout);
+
+                if (tops > best_tops)
+                {
+                    best_tops = tops;
+                    best_rows = grid_sizes[r];
+                    best_cols = grid_sizes[c];
+                }
+            }
+        }
+
+        if (best_tops > 0)
+            fprintf(stdout, "  best %dx%d = %.2f TOPS", best_rows, best_cols, best_tops);
+        fprintf(stdout, "\n");
+    }
+}
+
+// one peak test kept busy for duration_s, the time series shows when and how far the gpu throttles
+static void run_sustained(int loop, int count_mb, int storage_type, int arithmetic_type, int packing_type, int duration_s)
+{
+    if (storage_type == -1)
+    {
+        // fp32-vec4
+        storage_type = 0;
+        arithmetic_type = 0;
+        packing_type = 4;
+    }
+
+    fprintf(stdout, "storage=%d arithmetic=%d packing=%d duration=%ds\n", storage_type, arithmetic_type, packing_type, duration_s);
+    fflush(stdout);
+
+    vkpeak_set_sustained(duration_s * 1000);
+
+    vkpeak(loop, count_mb, 1, storage_type, arithmetic_type, packing_type);
+
+    vkpeak_set_sustained(0);
+
+    vkpeak_sustained sustained;
+    vkpeak_get_sustained(&sustained);
+
+    std::vector<double> times(sustained.sample_count);
+    std::vector<double> values(sustained.sample_count);
+    int count = vkpeak_get_sustained_samples(times.data(), values.data(), sustained.sample_count);
+
+    for (int i = 0; i < count; i++)
+    {
+        fprintf(stdout, "%10.3f s = %.2f GFLOPS\n", times[i] / 1000, values[i]);
+    }
+
+    fprintf(stdout, "\n");
+    fprintf(stdout, "%-12s = %.2f GFLOPS\n", "peak", sustained.peak);
+    fprintf(stdout, "%-12s = %.2f GFLOPS\n", "steady", sustained.steady);
+    fprintf(stdout, "%-12s = %.1f%%\n", "steady/peak", sustained.steady_ratio * 100);
+    if (sustained.throttle_ms >= 0)
+        fprintf(stdout, "%-12s = %.1f s\n", "throttle", sustained.throttle_ms / 1000);
+    else
+        fprintf(stdout, "%-12s = none\n", "throttle");
+}
+
+// one peak test split over 1 to compute_queue_count queues
+// a gain over a single queue means one queue cannot keep the whole gpu busy
+static void run_queue(int loop, int count_mb, int cmd_loop, int storage_type, int arithmetic_type, int packing_type)
+{
+    if (storage_type == -1)
+    {
+        // fp32-vec4
+        storage_type = 0;
+        arithmetic_type = 0;
+        packing_type = 4;
+    }
+
+    const int max_queue_count = (int)vkpeak_get_device()->info.compute_queue_count();
+
+    fprintf(stdout, "storage=%d arithmetic=%d packing=%d\n", storage_type, arithmetic_type, packing_type);
+
+    double gflops_single = 0;
+    for (int queue_count = 1; queue_count <= max_queue_count; queue_count++)
+    {
+        vkpeak_set_queue_count(queue_count);
+
+        double gflops = vkpeak(loop, count_mb, cmd_loop, storage_type, arithmetic_type, packing_type);
+        if (queue_count == 1)
+            gflops_single = gflops;
+
+        char name[64];
+        sprintf(name, "%d-queue", queue_count);
+
+        fprintf(stdout, "%-18s = %.2f GFLOPS", name, gflops);
+        if (gflops_single > 0)
+            fprintf(stdout, "  %.2fx", gflops / gflops_single);
+        print_stats();
+        fprintf(stdout, "\n");
+        fflush(stdout);
+    }
+
+    vkpeak_set_queue_count(1);
+}
+
+struct vkpeak_cpu_config
+{
+    const char* name;
+    const char* unit;
+    int arithmetic_type;
+    int packing_type;
+};
+
+// the simd counterparts of the gpu fp32-vec4 fp16-vec4 int8-dotprod int8-matrix tests
+static const vkpeak_cpu_config cpu_configs[] = {
+    {"fp32-vec4", "GFLOPS", 0, 4},
+    {"fp16-vec4", "GFLOPS", 1, 4},
+    {"int8-dotprod", "GIOPS", 5, 4},
+    {"int8-matrix", "GIOPS", 5, 256},
+};
+
+static void run_cpu(int loop, int cmd_loop)
+{
+    const int config_count = sizeof(cpu_configs) / sizeof(cpu_configs[0]);
+    for (int i = 0; i < config_count; i++)
+    {
+        const vkpeak_cpu_config& cfg = cpu_configs[i];
+
+        double gflops_single = vkpeak_cpu(loop, cmd_loop, 1, cfg.arithmetic_type, cfg.packing_type);
+        double gflops_multi = vkpeak_cpu(loop, cmd_loop, 0, cfg.arithmetic_type, cfg.packing_type);
+
+        char name[64];
+        sprintf(name, "%s-%s", cfg.name, vkpeak_cpu_kernel_name(cfg.arithmetic_type, cfg.packing_type));
+
+        fprintf(stdout, "%-22s = %.2f / %.2f %s\n", name, gflops_single, gflops_multi, cfg.unit);
+        fflush(stdout);
+    }
+}
+
+// every cpu test on 1 to all cores of each cluster, one pinned thread per core
+static void run_cluster(int loop, int cmd_loop)
+{
+    const int cluster_count = vkpeak_cpu_cluster_count();
+    for (int c = 0; c < cluster_count; c++)
+    {
+        const int core_count = vkpeak_cpu_cluster_core_count(c);
+        const int max_freq = vkpeak_cpu_cluster_max_freq(c);
+
+        if (max_freq > 0)
+            fprintf(stdout, "cluster %d, %d cores, %d MHz\n", c, core_count, max_freq);
+        else
+            fprintf(stdout, "cluster %d, %d cores\n", c, core_count);
+
+        const int config_count = sizeof(cpu_configs) / sizeof(cpu_configs[0]);
+        for (int i = 0; i < config_count; i++)
+        {
+            const vkpeak_cpu_config& cfg = cpu_configs[i];
+
+            for (int thread_count = 1; thread_count <= core_count; thread_count++)
+            {
+                double gflops = vkpeak_cpu_cluster(loop, cmd_loop, c, thread_count, cfg.arithmetic_type, cfg.packing_type);
+
+                char name[64];
+                sprintf(name, "%s-%s-x%d", cfg.name, vkpeak_cpu_kernel_name(cfg.arithmetic_type, cfg.packing_type), thread_count);
+
+                fprintf(stdout, "%-26s = %.2f %s\n", name, gflops, cfg.unit);
+                fflush(stdout);
+
+                // no kernel for this cpu, skip the other core counts
+                if (gflops == 0)
+                    break;
+            }
+        }
+    }
+}
+
+static const char* const dot_signedness_names[] = {"s8*s8", "u8*u8", "s8*u8"};
+
+// every packed integer dot product next to the accelerated flag the driver reports for it
+static void run_dot(int loop, int count_mb, int cmd_loop)
+{
+    for (int signedness_type = 0; signedness_type < 3; signedness_type++)
+    {
+        for (int saturating = 0; saturating < 2; saturating++)
+        {
+            const bool accelerated = vkpeak_dot_accelerated(signedness_type, saturating);
+
+            for (int packing_type = 4; packing_type <= 8; packing_type += 4)
+            {
+                double gops = vkpeak_dot(loop, count_mb, cmd_loop, signedness_type, saturating, packing_type);
+
+                char name[64];
+                sprintf(name, "%s-%s%s", packing_type == 8 ? "int4" : "int8", dot_signedness_names[signedness_type], saturating ? "-sat" : "");
+
+                fprintf(stdout, "%-18s = %.2f GIOPS", name, gops);
+                print_stats();
+                fprintf(stdout, "  %s\n", accelerated ? "accelerated" : "not accelerated");
+                fflush(stdout);
+            }
+        }
+    }
+}
+
+struct vkpeak_gemm_shape
+{
+    int M;
+    int N;
+    int K;
+};
+
+// decode like single and few token rows up to prefill like square matrices
+static const vkpeak_gemm_shape gemm_shapes[] = {
+    {1, 4096, 4096},
+    {8, 4096, 4096},
+    {32, 4096, 4096},
+    {128, 4096, 4096},
+    {512, 512, 512},
+    {1024, 1024, 1024},
+    {2048, 2048, 2048},
+    {4096, 4096, 4096},
+};
+
+static const char* const gemm_names[] = {"sgemm", "hgemm", "matrix"};
+
+// practical gemm next to the synthetic peak of the same arithmetic, measured in the same session
+static void run_gemm(int loop, int count_mb, int cmd_loop)
+{
+    // fp32-vec4 fp16-vec4 fp16-matrix
+    double peaks[3];
+    peaks[0] = vkpeak(loop, count_mb, cmd_loop, 0, 0, 4);
+    peaks[1] = vkpeak(loop, count_mb, cmd_loop, 0, 1, 4);
+    peaks[2] = vkpeak(loop, count_mb, cmd_loop, 1, 1, 256);
+
+    fprintf(stdout, "peak fp32-vec4 = %.2f  fp16-vec4 = %.2f  fp16-matrix = %.2f GFLOPS\n", peaks[0], peaks[1], peaks[2]);
+    fprintf(stdout, "\n");
+
+    const int shape_count = sizeof(gemm_shapes) / sizeof(gemm_shapes[0]);
+    for (int i = 0; i < shape_count; i++)
+    {
+        const vkpeak_gemm_shape& shape = gemm_shapes[i];
+
+        char name[64];
+        sprintf(name, "%dx%dx%d", shape.M, shape.N, shape.K);
+
+        fprintf(stdout, "%-16s =", name);
+
+        for (int gemm_type = 0; gemm_type < 3; gemm_type++)
+        {
+            double gflops = vkpeak_gemm(cmd_loop, gemm_type, shape.M, shape.N, shape.K);
+
+            fprintf(stdout, "  %s %.2f", gemm_names[gemm_type], gflops);
+            if (peaks[gemm_type] > 0 && gflops > 0)
+                fprintf(stdout, " (%.1f%%)", gflops / peaks[gemm_type] * 100);
+            fflush(stdout);
+        }
+
+        fprintf(stdout, "\n");
+    }
+}
+
+static void run_bandwidth(int loop, int count_mb, int cmd_loop)
+{
+    const int config_count = sizeof(bandwidth_configs) / sizeof(bandwidth_configs[0]);
+    for (int i = 0; i < config_count; i++)
+    {
+        const vkpeak_bandwidth_config& cfg = bandwidth_configs[i];
+
+        for (int access_type = 0; access_type < 4; access_type++)
+        {
+            double gbps = vkpeak_bandwidth(loop, count_mb, cmd_loop, cfg.storage_type, access_type, cfg.packing_type);
+
+            char name[64];
+            sprintf(name, "%s-%s", cfg.name, access_names[access_type]);
+
+            fprintf(stdout, "%-18s = %.2f GB/s", name, gbps);
+            print_stats();
+            fprintf(stdout, "\n");
+            fflush(stdout);
+        }
+    }
+}
+
+static void run_shared(int loop, int count_mb, int cmd_loop)
+{
+    const int stride_count = sizeof(shared_strides) / sizeof(shared_strides[0]);
+    for (int access_type = 0; access_type < 2; access_type++)
+    {
+        double gbps_stride1 = 0;
+
+        for (int i = 0; i < stride_count; i++)
+        {
+            const int stride = shared_strides[i];
+
+            double gbps = vkpeak_shared(loop, count_mb, cmd_loop, access_type, stride);
+            if (stride == 1)
+                gbps_stride1 = gbps;
+
+            char name[64];
+            sprintf(name, "shared-%s-stride%d", shared_access_names[access_type], stride);
+
+            // slowdown against the conflict free access
+            double slowdown = gbps > 0 ? gbps_stride1 / gbps : 0;
+
+            fprintf(stdout, "%-22s = %.2f GB/s  %.2fx", name, gbps, slowdown);
+            print_stats();
+            fprintf(stdout, "\n");
+            fflush(stdout);
+        }
+    }
+}
+
+static void run_subgroup(int loop, int count_mb, int cmd_loop)
+{
+    const int config_count = sizeof(subgroup_configs) / sizeof(subgroup_configs[0]);
+    for (int i = 0; i < config_count; i++)
+    {
+        const vkpeak_subgroup_config& cfg = subgroup_configs[i];
+
+        char name[64];
+
+        // the scalar fma peak of the same type for reference
+        double gflops = vkpeak(loop, count_mb, cmd_loop, cfg.storage_type, cfg.arithmetic_type, 1);
+
+        sprintf(name, "%s-fma", cfg.name);
+        fprintf(stdout, "%-18s = %.2f %s", name, gflops, cfg.unit);
+        print_stats();
+        fprintf(stdout, "\n");
+        fflush(stdout);
+
+        for (int op_type = 0; op_type < 5; op_type++)
+        {
+            double gops = vkpeak_subgroup(loop, count_mb, cmd_loop, cfg.arithmetic_type, op_type);
+
+            sprintf(name, "%s-%s", cfg.name, subgroup_op_names[op_type]);
+            fprintf(stdout, "%-18s = %.2f Gops/s", name, gops);
+            print_stats();
+            fprintf(stdout, "\n");
+            fflush(stdout);
+        }
+    }
+}
+
+static void run_sfu(int loop, int count_mb, int cmd_loop)
+{
+    const int config_count = sizeof(sfu_configs) / sizeof(sfu_configs[0]);
+    for (int i = 0; i < config_count; i++)
+    {
+        const vkpeak_sfu_config& cfg = sfu_configs[i];
+
+        for (int func_type = 0; func_type < 5; func_type++)
+        {
+            double gops = vkpeak_sfu(loop, count_mb, cmd_loop, cfg.arithmetic_type, cfg.packing_type, func_type);
+
+            char name[64];
+            sprintf(name, "%s-%s", cfg.name, sfu_func_names[func_type]);
+
+            fprintf(stdout, "%-18s = %.2f Gops/s", name, gops);
+            print_stats();
+            fprintf(stdout, "\n");
+            fflush(stdout);
+        }
+    }
+}
+
+static void run_latency(int loop, int cmd_loop, int count_mb)
+{
+    for (int walker_type = 0; walker_type < 2; walker_type++)
+    {
+        fprintf(stdout, "%s walker\n", walker_type == 0 ? "thread" : "subgroup");
+
+        // 4KB to count_mb in 1.5x / 1.33x steps
+        double last_ns = 0;
+        for (int footprint_kb = 4; footprint_kb <= count_mb * 1024; )
+        {
+            double ns = vkpeak_latency(loop, cmd_loop, footprint_kb, walker_type);
+
+            char name[64];
+            if (footprint_kb >= 1024)
+                sprintf(name, "%.1fMB", footprint_kb / 1024.0);
+            else
+                sprintf(name, "%dKB", footprint_kb);
+
+            // mark the working set size where latency jumps to the next cache level
+            const bool cliff = last_ns > 0 && ns > last_ns * 1.3;
+
+            fprintf(stdout, "%-12s = %.2f ns%s\n", name, ns, cliff ? "  <- cliff" : "");
+            fflush(stdout);
+
+            if (ns > 0)
+                last_ns = ns;
+
+            // 4 6 8 12 16 24 ...
+            footprint_kb = (footprint_kb & (footprint_kb - 1)) == 0 ? footprint_kb * 3 / 2 : footprint_kb * 4 / 3;
+        }
+    }
+}
+
+// $XDG_CACHE_HOME/vkpeak or ~/.cache/vkpeak, created on demand
+static std::string default_cache_dir()
+{
+    std::string cache_home;
+
+    const char* xdg_cache_home = getenv("XDG_CACHE_HOME");
+    const char* home = getenv("HOME");
+    if (xdg_cache_home && xdg_cache_home[0] != '\0')
+    {
+        cache_home = xdg_cache_home;
+    }
+    else if (home && home[0] != '\0')
+    {
+        cache_home = std::string(home) + "/.cache";
+        mkdir(cache_home.c_str(), 0755);
+    }
+    else
+    {
+        return std::string();
+    }
+
+    std::string cache_dir = cache_home + "/vkpeak";
+    mkdir(cache_dir.c_str(), 0755);
+
+    return cache_dir;
+}
+
+int main(int argc, char** argv)
+{
+    const char* mode = "peak";
+    int loop = 20;
+    int count_mb = -1;
+    int cmd_loop = 5;
+    int storage_type = -1;
+    int arithmetic_type = -1;
+    int packing_type = -1;
+    int timing_type = 0;
+    int loop_type = 0;
+    int dispatch_count = 1;
+    double cv_threshold = 0;
+    int time_budget_ms = 10000;
+    int device_index = -1;
+    int queue_count = 1;
+    int duration_s = 60;
+    int local_size_x = 0;
+    const char* cache_dir = 0;
+
+    int opt;
+    while ((opt = getopt(argc, argv, "m:l:c:r:s:a:p:d:t:u:b:q:v:g:w:x:k:h")) != -1)
+    {
+        switch (opt)
+        {
+        case 'm':
+            mode = optarg;
+            break;
+        case 'l':
+            loop = atoi(optarg);
+            break;
+        case 'c':
+            count_mb = atoi(optarg);
+            break;
+        case 'r':
+            cmd_loop = atoi(optarg);
+            break;
+        case 's':
+            storage_type = atoi(optarg);
+            break;
+        case 'a':
+            arithmetic_type = atoi(optarg);
+            break;
+        case 'p':
+            packing_type = atoi(optarg);
+            break;
+        case 'd':
+            device_index = atoi(optarg);
+            break;
+        case 't':
+            timing_type = atoi(optarg);
+            break;
+        case 'u':
+            loop_type = atoi(optarg);
+            break;
+        case 'b':
+            dispatch_count = atoi(optarg);
+            break;
+        case 'q':
+            queue_count = atoi(optarg);
+            break;
+        case 'v':
+            cv_threshold = atof(optarg);
+            break;
+        case 'g':
+            time_budget_ms = atoi(optarg);
+            break;
+        case 'w':
+            duration_s = atoi(optarg);
+            break;
+        case 'x':
+            local_size_x = atoi(optarg);
+            break;
+        case 'k':
+            cache_dir = optarg;
+            break;
+        case 'h':
+        default:
+            print_usage(argv[0]);
+            return -1;
+        }
+    }
+
+    bool mode_found = false;
+    for (size_t i = 0; i < sizeof(modes) / sizeof(modes[0]); i++)
+    {
+        if (strcmp(mode, modes[i]) == 0)
+            mode_found = true;
+    }
+    if (!mode_found)
+    {
+        fprintf(stderr, "unknown mode %s\n", mode);
+        print_usage(argv[0]);
+        return -1;
+    }
+
+    if (count_mb == -1)
+    {
+        // bandwidth wants a footprint far beyond the gpu caches
+        count_mb = strcmp(mode, "bandwidth") == 0 || strcmp(mode, "latency") == 0 ? 512 : 5;
+    }
+
+    const bool run_single = storage_type != -1 || arithmetic_type != -1 || packing_type != -1;
+    if (run_single && (storage_type == -1 || arithmetic_type == -1 || packing_type == -1))
+    {
+        fprintf(stderr, "-s -a -p must be given together\n");
+        print_usage(argv[0]);
+        return -1;
+    }
+
+    if (run_single && (storage_type < 0 || storage_type > 5 || arithmetic_type < 0 || arithmetic_type > 8 || (packing_type != 1 && packing_type != 4 && packing_type != 256)))
+    {
+        fprintf(stderr, "invalid storage_type %d arithmetic_type %d packing_type %d\n", storage_type, arithmetic_type, packing_type);
+        print_usage(argv[0]);
+        return -1;
+    }
+
+    if (loop <= 0 || count_mb <= 0 || cmd_loop <= 0 || (timing_type != 0 && timing_type != 1) || (loop_type != 0 && loop_type != 1) || dispatch_count <= 0 || queue_count <= 0 || cv_threshold < 0 || time_budget_ms <= 0 || duration_s <= 0 || local_size_x < 0)
+    {
+        print_usage(argv[0]);
+        return -1;
+    }
+
+    if (strcmp(mode, "cpu") == 0 || strcmp(mode, "cluster") == 0)
+    {
+        // no vulkan device needed
+        fprintf(stdout, "ncnn         = %s\n", NCNN_VERSION_STRING);
+        fprintf(stdout, "cpu cores    = %d\n", ncnn::get_cpu_count());
+        fprintf(stdout, "cpu clusters = %d\n", vkpeak_cpu_cluster_count());
+        fprintf(stdout, "\n");
+
+        if (strcmp(mode, "cpu") == 0)
+        {
+            fprintf(stdout, "single core / all cores\n");
+            run_cpu(loop, cmd_loop);
+        }
+        else
+        {
+            run_cluster(loop, cmd_loop);
+        }
+
+        return 0;
+    }
+
+    vkpeak_set_timing_type(timing_type);
+    vkpeak_set_loop_type(loop_type);
+    vkpeak_set_dispatch_count(dispatch_count);
+    vkpeak_set_queue_count(queue_count);
+    vkpeak_set_sampler(cv_threshold, time_budget_ms);
+    vkpeak_set_local_size(local_size_x);
+    g_print_stats = cv_threshold > 0;
+
+    vkpeak_set_cache_dir(cache_dir ? cache_dir : default_cache_dir().c_str());
+
+    ncnn::create_gpu_instance();
+
+    if (ncnn::get_gpu_count() == 0)
+    {
+        fprintf(stderr, "No vulkan device\n");
+        ncnn::destroy_gpu_instance();
+        return -1;
+    }
+
+    if (device_index < -1 || device_index >= ncnn::get_gpu_count())
+    {
+        fprintf(stderr, "device index %d out of range, %d vulkan devices\n", device_index, ncnn::get_gpu_count());
+        ncnn::destroy_gpu_instance();
+        return -1;
+    }
+
+    vkpeak_set_device_index(device_index);
+
+    {
+        const ncnn::GpuInfo& info = ncnn::get_gpu_info(device_index == -1 ? ncnn::get_default_gpu_index() : device_index);
+
+        uint32_t api_version = info.api_version();
+        uint32_t driver_version = info.driver_version();
+
+        fprintf(stdout, "ncnn         = %s\n", NCNN_VERSION_STRING);
+        fprintf(stdout, "device       = %s\n", info.device_name());
+        if (ncnn::get_gpu_count() > 1)
+        {
+            for (int i = 0; i < ncnn::get_gpu_count(); i++)
+            {
+                fprintf(stdout, "gpu%-3d       = %s\n", i, ncnn::get_gpu_info(i).device_name());
+            }
+        }
+        fprintf(stdout, "api          = %u.%u.%u\n", VK_VERSION_MAJOR(api_version), VK_VERSION_MINOR(api_version), VK_VERSION_PATCH(api_version));
+        fprintf(stdout, "driver       = %u.%u.%u\n", VK_VERSION_MAJOR(driver_version), VK_VERSION_MINOR(driver_version), VK_VERSION_PATCH(driver_version));
+
+        const bool timestamp = timing_type == 0 && vkpeak_support_timestamp(vkpeak_get_device());
+        fprintf(stdout, "timing       = %s\n", timestamp ? "gpu timestamp" : "host");
+        fprintf(stdout, "queues       = %u\n", info.compute_queue_count());
+        fprintf(stdout, "\n");
+    }
+
+    if (strcmp(mode, "bandwidth") == 0)
+    {
+        run_bandwidth(loop, count_mb, cmd_loop);
+    }
+    else if (strcmp(mode, "shared") == 0)
+    {
+        run_shared(loop, count_mb, cmd_loop);
+    }
+    else if (strcmp(mode, "subgroup") == 0)
+    {
+        run_subgroup(loop, count_mb, cmd_loop);
+    }
+    else if (strcmp(mode, "sfu") == 0)
+    {
+        run_sfu(loop, count_mb, cmd_loop);
+    }
+    else if (strcmp(mode, "latency") == 0)
+    {
+        run_latency(loop, cmd_loop, count_mb);
+    }
+    else if (strcmp(mode, "queue") == 0)
+    {
+        run_queue(loop, count_mb, cmd_loop, storage_type, arithmetic_type, packing_type);
+    }
+    else if (strcmp(mode, "matrix") == 0)
+    {
+        run_matrix(loop, count_mb, cmd_loop);
+    }
+    else if (strcmp(mode, "block") == 0)
+    {
+        fprintf(stdout, "rowsxcols:TOPS\n");
+        run_block(loop, count_mb, cmd_loop);
+    }
+    else if (strcmp(mode, "dot") == 0)
+    {
+        run_dot(loop, count_mb, cmd_loop);
+    }
+    else if (strcmp(mode, "gemm") == 0)
+    {
+        fprintf(stdout, "MxNxK = GFLOPS (percent of peak)\n");
+        run_gemm(loop, count_mb, cmd_loop);
+    }
+    else if (strcmp(mode, "depth") == 0)
+    {
+        fprintf(stdout, "unroll:GFLOPS\n");
+        run_depth(loop, count_mb, cmd_loop);
+    }
+    else if (strcmp(mode, "ilp") == 0)
+    {
+        fprintf(stdout, "chains:GFLOPS\n");
+        run_ilp(loop, count_mb, cmd_loop);
+    }
+    else if (strcmp(mode, "wgsize") == 0)
+    {
+        fprintf(stdout, "local_size_x:GFLOPS\n");
+        run_wgsize(loop, count_mb, cmd_loop);
+    }
+    else if (strcmp(mode, "sustained") == 0)
+    {
+        run_sustained(loop, count_mb, storage_type, arithmetic_type, packing_type, duration_s);
+    }
+    else if (strcmp(mode, "multi") == 0)
+    {
+        run_multi(loop, count_mb, cmd_loop, storage_type, arithmetic_type, packing_type);
+    }
+    else if (strcmp(mode, "unroll") == 0)
+    {
+        fprintf(stdout, "specialization constant loop / push constant loop\n");
+        run_unroll(loop, count_mb, cmd_loop);
+    }
+    else
+    {
+        run_peak(loop, count_mb, cmd_loop, storage_type, arithmetic_type, packing_type);
+    }
+
+    ncnn::destroy_gpu_instance();
+
+    return 0;
+}
@@ -0,0 +1,1945 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "vkpeak.h"
+#include "vkpeak_runner.h"
+
+#include <float.h>
+#include <stdio.h>
+#include <algorithm>
+#include <string>
+#include <vector>
+
+// ncnn
+#include <benchmark.h>
+#include <command.h>
+#include <cpu.h>
+#include <gpu.h>
+#include <mat.h>
+#include <pipeline.h>
+#include <platform.h>
+
+static const char glsl_fp16_matrix_nv_data[] = R"(
+#version 450
+
+#extension GL_EXT_shader_explicit_arithmetic_types_float16: require
+#extension GL_KHR_memory_scope_semantics: require
+#extension GL_EXT_shader_explicit_arithmetic_types: require
+#extension GL_NV_cooperative_matrix: require
+
+layout (constant_id = 0) const int loop = 1;
+layout (constant_id = 1) const int M = 1;
+layout (constant_id = 2) const int N = 1;
+layout (constant_id = 3) const int K = 1;
+
+layout (binding = 0) writeonly buffer c_blob { float c_blob_data[]; };
+
+void main()
+{
+    const uint gx = gl_GlobalInvocationID.x;
+    const uint lx = gl_LocalInvocationID.x;
+
+    fcoopmatNV<16, gl_ScopeSubgroup, M, K> a = fcoopmatNV<16, gl_ScopeSubgroup, M, K>(float(gx));
+    fcoopmatNV<16, gl_ScopeSubgroup, K, N> b = fcoopmatNV<16, gl_ScopeSubgroup, K, N>(float(lx));
+
+    fcoopmatNV<16, gl_ScopeSubgroup, M, N> c = fcoopmatNV<16, gl_ScopeSubgroup, M, N>(float(gx));
+
+    for (int i = 0; i < loop; i++)
+    {
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+    }
+
+    coopMatStoreNV(c, c_blob_data, gx * (M * N) / 2, N / 2, false);
+}
+)";
+
+static const char glsl_fp16_matrix_dual_nv_data[] = R"(
+#version 450
+
+#extension GL_EXT_shader_explicit_arithmetic_types_float16: require
+#extension GL_KHR_memory_scope_semantics: require
+#extension GL_EXT_shader_explicit_arithmetic_types: require
+#extension GL_NV_cooperative_matrix: require
+
+layout (constant_id = 0) const int loop = 1;
+layout (constant_id = 1) const int M = 1;
+layout (constant_id = 2) const int N = 1;
+layout (constant_id = 3) const int K = 1;
+
+layout (binding = 0) writeonly buffer c_blob { float c_blob_data[]; };
+
+void main()
+{
+    const uint gx = gl_GlobalInvocationID.x;
+    const uint lx = gl_LocalInvocationID.x;
+
+    fcoopmatNV<16, gl_ScopeSubgroup, M, K> a = fcoopmatNV<16, gl_ScopeSubgroup, M, K>(float(gx));
+    fcoopmatNV<16, gl_ScopeSubgroup, K, N> b = fcoopmatNV<16, gl_ScopeSubgroup, K, N>(float(lx));
+
+    fcoopmatNV<16, gl_ScopeSubgroup, M, N> c0 = fcoopmatNV<16, gl_ScopeSubgroup, M, N>(float(gx));
+    fcoopmatNV<16, gl_ScopeSubgroup, M, N> c1 = fcoopmatNV<16, gl_ScopeSubgroup, M, N>(float(lx));
+
+    for (int i = 0; i < loop; i++)
+    {
+        c0 = coopMatMulAddNV(a, b, c0);
+        c1 = coopMatMulAddNV(a, b, c1);
+        c0 = coopMatMulAddNV(a, b, c0);
+        c1 = coopMatMulAddNV(a, b, c1);
+        c0 = coopMatMulAddNV(a, b, c0);
+        c1 = coopMatMulAddNV(a, b, c1);
+        c0 = coopMatMulAddNV(a, b, c0);
+        c1 = coopMatMulAddNV(a, b, c1);
+        c0 = coopMatMulAddNV(a, b, c0);
+        c1 = coopMatMulAddNV(a, b, c1);
+        c0 = coopMatMulAddNV(a, b, c0);
+        c1 = coopMatMulAddNV(a, b, c1);
+        c0 = coopMatMulAddNV(a, b, c0);
+        c1 = coopMatMulAddNV(a, b, c1);
+        c0 = coopMatMulAddNV(a, b, c0);
+        c1 = coopMatMulAddNV(a, b, c1);
+    }
+
+    c0 = c0 + c1;
+    coopMatStoreNV(c0, c_blob_data, gx * (M * N) / 2, N / 2, false);
+}
+)";
+
+static const char glsl_fp16_matrix_khr_data[] = R"(
+#version 450
+
+#extension GL_EXT_shader_explicit_arithmetic_types_float16: require
+#extension GL_KHR_memory_scope_semantics: require
+#extension GL_EXT_shader_explicit_arithmetic_types: require
+#extension GL_KHR_cooperative_matrix: require
+
+layout (constant_id = 0) const int loop = 1;
+layout (constant_id = 1) const int M = 1;
+layout (constant_id = 2) const int N = 1;
+layout (constant_id = 3) const int K = 1;
+
+layout (binding = 0) writeonly buffer c_blob { float c_blob_data[]; };
+
+void main()
+{
+    const uint gx = gl_GlobalInvocationID.x;
+    const uint lx = gl_LocalInvocationID.x;
+
+    coopmat<float16_t, gl_ScopeSubgroup, M, K, gl_MatrixUseA> a = coopmat<float16_t, gl_ScopeSubgroup, M, K, gl_MatrixUseA>(float(gx));
+    coopmat<float16_t, gl_ScopeSubgroup, K, N, gl_MatrixUseB> b = coopmat<float16_t, gl_ScopeSubgroup, K, N, gl_MatrixUseB>(float(lx));
+
+    coopmat<float16_t, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator> c = coopmat<float16_t, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator>(float(gx));
+
+    for (int i = 0; i < loop; i++)
+    {
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+    }
+
+    coopMatStore(c, c_blob_data, gx * (M * N) / 2, N / 2, gl_CooperativeMatrixLayoutRowMajor);
+}
+)";
+
+static const char glsl_fp16_matrix_dual_khr_data[] = R"(
+#version 450
+
+#extension GL_EXT_shader_explicit_arithmetic_types_float16: require
+#extension GL_KHR_memory_scope_semantics: require
+#extension GL_EXT_shader_explicit_arithmetic_types: require
+#extension GL_KHR_cooperative_matrix: require
+
+layout (constant_id = 0) const int loop = 1;
+layout (constant_id = 1) const int M = 1;
+layout (constant_id = 2) const int N = 1;
+layout (constant_id = 3) const int K = 1;
+
+layout (binding = 0) writeonly buffer c_blob { float c_blob_data[]; };
+
+void main()
+{
+    const uint gx = gl_GlobalInvocationID.x;
+    const uint lx = gl_LocalInvocationID.x;
+
+    coopmat<float16_t, gl_ScopeSubgroup, M, K, gl_MatrixUseA> a = coopmat<float16_t, gl_ScopeSubgroup, M, K, gl_MatrixUseA>(float(gx));
+    coopmat<float16_t, gl_ScopeSubgroup, K, N, gl_MatrixUseB> b = coopmat<float16_t, gl_ScopeSubgroup, K, N, gl_MatrixUseB>(float(lx));
+
+    coopmat<float16_t, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator> c0 = coopmat<float16_t, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator>(float(gx));
+    coopmat<float16_t, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator> c1 = coopmat<float16_t, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator>(float(lx));
+
+    for (int i = 0; i < loop; i++)
+    {
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+    }
+
+    c0 = c0 + c1;
+    coopMatStore(c0, c_blob_data, gx * (M * N) / 2, N / 2, gl_CooperativeMatrixLayoutRowMajor);
+}
+)";
+
+static const char glsl_fp16_fp32_matrix_nv_data[] = R"(
+#version 450
+
+#extension GL_EXT_shader_explicit_arithmetic_types_float16: require
+#extension GL_KHR_memory_scope_semantics: require
+#extension GL_EXT_shader_explicit_arithmetic_types: require
+#extension GL_NV_cooperative_matrix: require
+
+layout (constant_id = 0) const int loop = 1;
+layout (constant_id = 1) const int M = 1;
+layout (constant_id = 2) const int N = 1;
+layout (constant_id = 3) const int K = 1;
+
+layout (binding = 0) writeonly buffer c_blob { float c_blob_data[]; };
+
+void main()
+{
+    const uint gx = gl_GlobalInvocationID.x;
+    const uint lx = gl_LocalInvocationID.x;
+
+    fcoopmatNV<16, gl_ScopeSubgroup, M, K> a = fcoopmatNV<16, gl_ScopeSubgroup, M, K>(float(gx));
+    fcoopmatNV<16, gl_ScopeSubgroup, K, N> b = fcoopmatNV<16, gl_ScopeSubgroup, K, N>(float(lx));
+
+    fcoopmatNV<32, gl_ScopeSubgroup, M, N> c = fcoopmatNV<32, gl_ScopeSubgroup, M, N>(float(gx));
+
+    for (int i = 0; i < loop; i++)
+    {
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+    }
+
+    coopMatStoreNV(c, c_blob_data, gx * (M * N), N, false);
+}
+)";
+
+static const char glsl_fp16_fp32_matrix_dual_nv_data[] = R"(
+#version 450
+
+#extension GL_EXT_shader_explicit_arithmetic_types_float16: require
+#extension GL_KHR_memory_scope_semantics: require
+#extension GL_EXT_shader_explicit_arithmetic_types: require
+#extension GL_NV_cooperative_matrix: require
+
+layout (constant_id = 0) const int loop = 1;
+layout (constant_id = 1) const int M = 1;
+layout (constant_id = 2) const int N = 1;
+layout (constant_id = 3) const int K = 1;
+
+layout (binding = 0) writeonly buffer c_blob { float c_blob_data[]; };
+
+void main()
+{
+    const uint gx = gl_GlobalInvocationID.x;
+    const uint lx = gl_LocalInvocationID.x;
+
+    fcoopmatNV<16, gl_ScopeSubgroup, M, K> a = fcoopmatNV<16, gl_ScopeSubgroup, M, K>(float(gx));
+    fcoopmatNV<16, gl_ScopeSubgroup, K, N> b = fcoopmatNV<16, gl_ScopeSubgroup, K, N>(float(lx));
+
+    fcoopmatNV<32, gl_ScopeSubgroup, M, N> c0 = fcoopmatNV<32, gl_ScopeSubgroup, M, N>(float(gx));
+    fcoopmatNV<32, gl_ScopeSubgroup, M, N> c1 = fcoopmatNV<32, gl_ScopeSubgroup, M, N>(float(lx));
+
+    for (int i = 0; i < loop; i++)
+    {
+        c0 = coopMatMulAddNV(a, b, c0);
+        c1 = coopMatMulAddNV(a, b, c1);
+        c0 = coopMatMulAddNV(a, b, c0);
+        c1 = coopMatMulAddNV(a, b, c1);
+        c0 = coopMatMulAddNV(a, b, c0);
+        c1 = coopMatMulAddNV(a, b, c1);
+        c0 = coopMatMulAddNV(a, b, c0);
+        c1 = coopMatMulAddNV(a, b, c1);
+        c0 = coopMatMulAddNV(a, b, c0);
+        c1 = coopMatMulAddNV(a, b, c1);
+        c0 = coopMatMulAddNV(a, b, c0);
+        c1 = coopMatMulAddNV(a, b, c1);
+        c0 = coopMatMulAddNV(a, b, c0);
+        c1 = coopMatMulAddNV(a, b, c1);
+        c0 = coopMatMulAddNV(a, b, c0);
+        c1 = coopMatMulAddNV(a, b, c1);
+    }
+
+    c0 = c0 + c1;
+    coopMatStoreNV(c0, c_blob_data, gx * (M * N), N, false);
+}
+)";
+
+static const char glsl_fp16_fp32_matrix_khr_data[] = R"(
+#version 450
+
+#extension GL_EXT_shader_explicit_arithmetic_types_float16: require
+#extension GL_KHR_memory_scope_semantics: require
+#extension GL_EXT_shader_explicit_arithmetic_types: require
+#extension GL_KHR_cooperative_matrix: require
+
+layout (constant_id = 0) const int loop = 1;
+layout (constant_id = 1) const int M = 1;
+layout (constant_id = 2) const int N = 1;
+layout (constant_id = 3) const int K = 1;
+
+layout (binding = 0) writeonly buffer c_blob { float c_blob_data[]; };
+
+void main()
+{
+    const uint gx = gl_GlobalInvocationID.x;
+    const uint lx = gl_LocalInvocationID.x;
+
+    coopmat<float16_t, gl_ScopeSubgroup, M, K, gl_MatrixUseA> a = coopmat<float16_t, gl_ScopeSubgroup, M, K, gl_MatrixUseA>(float(gx));
+    coopmat<float16_t, gl_ScopeSubgroup, K, N, gl_MatrixUseB> b = coopmat<float16_t, gl_ScopeSubgroup, K, N, gl_MatrixUseB>(float(lx));
+
+    coopmat<float, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator> c = coopmat<float, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator>(float(gx));
+
+    for (int i = 0; i < loop; i++)
+    {
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+    }
+
+    coopMatStore(c, c_blob_data, gx * (M * N), N, gl_CooperativeMatrixLayoutRowMajor);
+}
+)";
+
+static const char glsl_fp16_fp32_matrix_dual_khr_data[] = R"(
+#version 450
+
+#extension GL_EXT_shader_explicit_arithmetic_types_float16: require
+#extension GL_KHR_memory_scope_semantics: require
+#extension GL_EXT_shader_explicit_arithmetic_types: require
+#extension GL_KHR_cooperative_matrix: require
+
+layout (constant_id = 0) const int loop = 1;
+layout (constant_id = 1) const int M = 1;
+layout (constant_id = 2) const int N = 1;
+layout (constant_id = 3) const int K = 1;
+
+layout (binding = 0) writeonly buffer c_blob { float c_blob_data[]; };
+
+void main()
+{
+    const uint gx = gl_GlobalInvocationID.x;
+    const uint lx = gl_LocalInvocationID.x;
+
+    coopmat<float16_t, gl_ScopeSubgroup, M, K, gl_MatrixUseA> a = coopmat<float16_t, gl_ScopeSubgroup, M, K, gl_MatrixUseA>(float(gx));
+    coopmat<float16_t, gl_ScopeSubgroup, K, N, gl_MatrixUseB> b = coopmat<float16_t, gl_ScopeSubgroup, K, N, gl_MatrixUseB>(float(lx));
+
+    coopmat<float, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator> c0 = coopmat<float, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator>(float(gx));
+    coopmat<float, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator> c1 = coopmat<float, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator>(float(lx));
+
+    for (int i = 0; i < loop; i++)
+    {
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+    }
+
+    c0 = c0 + c1;
+    coopMatStore(c0, c_blob_data, gx * (M * N), N, gl_CooperativeMatrixLayoutRowMajor);
+}
+)";
+
+static const char glsl_int8_matrix_nv_data[] = R"(
+#version 450
+
+#extension GL_EXT_shader_explicit_arithmetic_types_int8: require
+#extension GL_KHR_memory_scope_semantics: require
+#extension GL_EXT_shader_explicit_arithmetic_types: require
+#extension GL_NV_cooperative_matrix: require
+#extension GL_NV_integer_cooperative_matrix : require
+
+layout (constant_id = 0) const int loop = 1;
+layout (constant_id = 1) const int M = 1;
+layout (constant_id = 2) const int N = 1;
+layout (constant_id = 3) const int K = 1;
+
+layout (binding = 0) writeonly buffer c_blob { int c_blob_data[]; };
+
+void main()
+{
+    const uint gx = gl_GlobalInvocationID.x;
+    const uint lx = gl_LocalInvocationID.x;
+
+    icoopmatNV<8, gl_ScopeSubgroup, M, K> a = icoopmatNV<8, gl_ScopeSubgroup, M, K>(int8_t(gx));
+    icoopmatNV<8, gl_ScopeSubgroup, K, N> b = icoopmatNV<8, gl_ScopeSubgroup, K, N>(int8_t(lx));
+
+    icoopmatNV<32, gl_ScopeSubgroup, M, N> c = icoopmatNV<32, gl_ScopeSubgroup, M, N>(int(gx));
+
+    for (int i = 0; i < loop; i++)
+    {
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+        c = coopMatMulAddNV(a, b, c);
+    }
+
+    coopMatStoreNV(c, c_blob_data, gx * (M * N), N, false);
+}
+)";
+
+static const char glsl_int8_matrix_dual_nv_data[] = R"(
+#version 450
+
+#extension GL_EXT_shader_explicit_arithmetic_types_int8: require
+#extension GL_KHR_memory_scope_semantics: require
+#extension GL_EXT_shader_explicit_arithmetic_types: require
+#extension GL_NV_cooperative_matrix: require
+#extension GL_NV_integer_cooperative_matrix : require
+
+layout (constant_id = 0) const int loop = 1;
+layout (constant_id = 1) const int M = 1;
+layout (constant_id = 2) const int N = 1;
+layout (constant_id = 3) const int K = 1;
+
+layout (binding = 0) writeonly buffer c_blob { int c_blob_data[]; };
+
+void main()
+{
+    const uint gx = gl_GlobalInvocationID.x;
+    const uint lx = gl_LocalInvocationID.x;
+
+    icoopmatNV<8, gl_ScopeSubgroup, M, K> a = icoopmatNV<8, gl_ScopeSubgroup, M, K>(int8_t(gx));
+    icoopmatNV<8, gl_ScopeSubgroup, K, N> b = icoopmatNV<8, gl_ScopeSubgroup, K, N>(int8_t(lx));
+
+    icoopmatNV<32, gl_ScopeSubgroup, M, N> c0 = icoopmatNV<32, gl_ScopeSubgroup, M, N>(int(gx));
+    icoopmatNV<32, gl_ScopeSubgroup, M, N> c1 = icoopmatNV<32, gl_ScopeSubgroup, M, N>(int(lx));
+
+    for (int i = 0; i < loop; i++)
+    {
+        c0 = coopMatMulAddNV(a, b, c0);
+        c1 = coopMatMulAddNV(a, b, c1);
+        c0 = coopMatMulAddNV(a, b, c0);
+        c1 = coopMatMulAddNV(a, b, c1);
+        c0 = coopMatMulAddNV(a, b, c0);
+        c1 = coopMatMulAddNV(a, b, c1);
+        c0 = coopMatMulAddNV(a, b, c0);
+        c1 = coopMatMulAddNV(a, b, c1);
+        c0 = coopMatMulAddNV(a, b, c0);
+        c1 = coopMatMulAddNV(a, b, c1);
+        c0 = coopMatMulAddNV(a, b, c0);
+        c1 = coopMatMulAddNV(a, b, c1);
+        c0 = coopMatMulAddNV(a, b, c0);
+        c1 = coopMatMulAddNV(a, b, c1);
+        c0 = coopMatMulAddNV(a, b, c0);
+        c1 = coopMatMulAddNV(a, b, c1);
+    }
+
+    c0 = c0 + c1;
+    coopMatStoreNV(c0, c_blob_data, gx * (M * N), N, false);
+}
+)";
+
+static const char glsl_int8_matrix_khr_data[] = R"(
+#version 450
+
+#extension GL_EXT_shader_explicit_arithmetic_types_float16: require
+#extension GL_KHR_memory_scope_semantics: require
+#extension GL_EXT_shader_explicit_arithmetic_types: require
+#extension GL_KHR_cooperative_matrix: require
+
+layout (constant_id = 0) const int loop = 1;
+layout (constant_id = 1) const int M = 1;
+layout (constant_id = 2) const int N = 1;
+layout (constant_id = 3) const int K = 1;
+
+layout (binding = 0) writeonly buffer c_blob { int c_blob_data[]; };
+
+void main()
+{
+    const uint gx = gl_GlobalInvocationID.x;
+    const uint lx = gl_LocalInvocationID.x;
+
+    coopmat<int8_t, gl_ScopeSubgroup, M, K, gl_MatrixUseA> a = coopmat<int8_t, gl_ScopeSubgroup, M, K, gl_MatrixUseA>(int8_t(gx));
+    coopmat<int8_t, gl_ScopeSubgroup, K, N, gl_MatrixUseB> b = coopmat<int8_t, gl_ScopeSubgroup, K, N, gl_MatrixUseB>(int8_t(lx));
+
+    coopmat<int, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator> c = coopmat<int, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator>(int(gx));
+
+    for (int i = 0; i < loop; i++)
+    {
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+    }
+
+    coopMatStore(c, c_blob_data, gx * (M * N), N, gl_CooperativeMatrixLayoutRowMajor);
+}
+)";
+
+static const char glsl_int8_matrix_dual_khr_data[] = R"(
+#version 450
+
+#extension GL_EXT_shader_explicit_arithmetic_types_float16: require
+#extension GL_KHR_memory_scope_semantics: require
+#extension GL_EXT_shader_explicit_arithmetic_types: require
+#extension GL_KHR_cooperative_matrix: require
+
+layout (constant_id = 0) const int loop = 1;
+layout (constant_id = 1) const int M = 1;
+layout (constant_id = 2) const int N = 1;
+layout (constant_id = 3) const int K = 1;
+
+layout (binding = 0) writeonly buffer c_blob { int c_blob_data[]; };
+
+void main()
+{
+    const uint gx = gl_GlobalInvocationID.x;
+    const uint lx = gl_LocalInvocationID.x;
+
+    coopmat<int8_t, gl_ScopeSubgroup, M, K, gl_MatrixUseA> a = coopmat<int8_t, gl_ScopeSubgroup, M, K, gl_MatrixUseA>(int8_t(gx));
+    coopmat<int8_t, gl_ScopeSubgroup, K, N, gl_MatrixUseB> b = coopmat<int8_t, gl_ScopeSubgroup, K, N, gl_MatrixUseB>(int8_t(lx));
+
+    coopmat<int, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator> c0 = coopmat<int, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator>(int(gx));
+    coopmat<int, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator> c1 = coopmat<int, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator>(int(lx));
+
+    for (int i = 0; i < loop; i++)
+    {
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+    }
+
+    c0 = c0 + c1;
+    coopMatStore(c0, c_blob_data, gx * (M * N), N, gl_CooperativeMatrixLayoutRowMajor);
+}
+)";
+
+static const char glsl_bf16_matrix_khr_data[] = R"(
+#version 450
+
+#extension GL_EXT_shader_explicit_arithmetic_types_float16: require
+#extension GL_KHR_memory_scope_semantics: require
+#extension GL_EXT_shader_explicit_arithmetic_types: require
+#extension GL_KHR_cooperative_matrix: require
+#extension GL_EXT_bfloat16: require
+
+layout (constant_id = 0) const int loop = 1;
+layout (constant_id = 1) const int M = 1;
+layout (constant_id = 2) const int N = 1;
+layout (constant_id = 3) const int K = 1;
+
+layout (binding = 0) writeonly buffer c_blob { float c_blob_data[]; };
+
+void main()
+{
+    const uint gx = gl_GlobalInvocationID.x;
+    const uint lx = gl_LocalInvocationID.x;
+
+    coopmat<bfloat16_t, gl_ScopeSubgroup, M, K, gl_MatrixUseA> a = coopmat<bfloat16_t, gl_ScopeSubgroup, M, K, gl_MatrixUseA>(float(gx));
+    coopmat<bfloat16_t, gl_ScopeSubgroup, K, N, gl_MatrixUseB> b = coopmat<bfloat16_t, gl_ScopeSubgroup, K, N, gl_MatrixUseB>(float(lx));
+
+    coopmat<bfloat16_t, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator> c = coopmat<bfloat16_t, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator>(float(gx));
+
+    for (int i = 0; i < loop; i++)
+    {
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+    }
+
+    coopMatStore(c, c_blob_data, gx * (M * N) / 2, N / 2, gl_CooperativeMatrixLayoutRowMajor);
+}
+)";
+
+static const char glsl_bf16_matrix_dual_khr_data[] = R"(
+#version 450
+
+#extension GL_EXT_shader_explicit_arithmetic_types_float16: require
+#extension GL_KHR_memory_scope_semantics: require
+#extension GL_EXT_shader_explicit_arithmetic_types: require
+#extension GL_KHR_cooperative_matrix: require
+#extension GL_EXT_bfloat16: require
+
+layout (constant_id = 0) const int loop = 1;
+layout (constant_id = 1) const int M = 1;
+layout (constant_id = 2) const int N = 1;
+layout (constant_id = 3) const int K = 1;
+
+layout (binding = 0) writeonly buffer c_blob { float c_blob_data[]; };
+
+void main()
+{
+    const uint gx = gl_GlobalInvocationID.x;
+    const uint lx = gl_LocalInvocationID.x;
+
+    coopmat<bfloat16_t, gl_ScopeSubgroup, M, K, gl_MatrixUseA> a = coopmat<bfloat16_t, gl_ScopeSubgroup, M, K, gl_MatrixUseA>(float(gx));
+    coopmat<bfloat16_t, gl_ScopeSubgroup, K, N, gl_MatrixUseB> b = coopmat<bfloat16_t, gl_ScopeSubgroup, K, N, gl_MatrixUseB>(float(lx));
+
+    coopmat<bfloat16_t, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator> c0 = coopmat<bfloat16_t, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator>(float(gx));
+    coopmat<bfloat16_t, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator> c1 = coopmat<bfloat16_t, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator>(float(lx));
+
+    for (int i = 0; i < loop; i++)
+    {
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+    }
+
+    coopmat<float, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator> c2 = coopmat<float, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator>(c0);
+    coopmat<float, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator> c3 = coopmat<float, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator>(c1);
+
+    c0 = coopmat<bfloat16_t, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator>(c2 + c3);
+    coopMatStore(c0, c_blob_data, gx * (M * N) / 2, N / 2, gl_CooperativeMatrixLayoutRowMajor);
+}
+)";
+
+static const char glsl_bf16_fp32_matrix_khr_data[] = R"(
+#version 450
+
+#extension GL_EXT_shader_explicit_arithmetic_types_float16: require
+#extension GL_KHR_memory_scope_semantics: require
+#extension GL_EXT_shader_explicit_arithmetic_types: require
+#extension GL_KHR_cooperative_matrix: require
+#extension GL_EXT_bfloat16: require
+
+layout (constant_id = 0) const int loop = 1;
+layout (constant_id = 1) const int M = 1;
+layout (constant_id = 2) const int N = 1;
+layout (constant_id = 3) const int K = 1;
+
+layout (binding = 0) writeonly buffer c_blob { float c_blob_data[]; };
+
+void main()
+{
+    const uint gx = gl_GlobalInvocationID.x;
+    const uint lx = gl_LocalInvocationID.x;
+
+    coopmat<bfloat16_t, gl_ScopeSubgroup, M, K, gl_MatrixUseA> a = coopmat<bfloat16_t, gl_ScopeSubgroup, M, K, gl_MatrixUseA>(float(gx));
+    coopmat<bfloat16_t, gl_ScopeSubgroup, K, N, gl_MatrixUseB> b = coopmat<bfloat16_t, gl_ScopeSubgroup, K, N, gl_MatrixUseB>(float(lx));
+
+    coopmat<float, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator> c = coopmat<float, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator>(float(gx));
+
+    for (int i = 0; i < loop; i++)
+    {
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+    }
+
+    coopMatStore(c, c_blob_data, gx * (M * N), N, gl_CooperativeMatrixLayoutRowMajor);
+}
+)";
+
+static const char glsl_bf16_fp32_matrix_dual_khr_data[] = R"(
+#version 450
+
+#extension GL_EXT_shader_explicit_arithmetic_types_float16: require
+#extension GL_KHR_memory_scope_semantics: require
+#extension GL_EXT_shader_explicit_arithmetic_types: require
+#extension GL_KHR_cooperative_matrix: require
+#extension GL_EXT_bfloat16: require
+
+layout (constant_id = 0) const int loop = 1;
+layout (constant_id = 1) const int M = 1;
+layout (constant_id = 2) const int N = 1;
+layout (constant_id = 3) const int K = 1;
+
+layout (binding = 0) writeonly buffer c_blob { float c_blob_data[]; };
+
+void main()
+{
+    const uint gx = gl_GlobalInvocationID.x;
+    const uint lx = gl_LocalInvocationID.x;
+
+    coopmat<bfloat16_t, gl_ScopeSubgroup, M, K, gl_MatrixUseA> a = coopmat<bfloat16_t, gl_ScopeSubgroup, M, K, gl_MatrixUseA>(float(gx));
+    coopmat<bfloat16_t, gl_ScopeSubgroup, K, N, gl_MatrixUseB> b = coopmat<bfloat16_t, gl_ScopeSubgroup, K, N, gl_MatrixUseB>(float(lx));
+
+    coopmat<float, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator> c0 = coopmat<float, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator>(float(gx));
+    coopmat<float, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator> c1 = coopmat<float, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator>(float(lx));
+
+    for (int i = 0; i < loop; i++)
+    {
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+    }
+
+    c0 = c0 + c1;
+    coopMatStore(c0, c_blob_data, gx * (M * N), N, gl_CooperativeMatrixLayoutRowMajor);
+}
+)";
+
+// the fp8 matrix kernels are shared by e4m3 and e5m2, glsl_fp8_e4m3_header or glsl_fp8_e5m2_header
+// goes in front and defines FP8T
+static const char glsl_fp8_e4m3_header[] = "#version 450\n#extension GL_EXT_float_e4m3: require\n#define FP8T floate4m3_t\n";
+static const char glsl_fp8_e5m2_header[] = "#version 450\n#extension GL_EXT_float_e5m2: require\n#define FP8T floate5m2_t\n";
+
+static const char glsl_fp8_fp16_matrix_khr_data[] = R"(
+#extension GL_EXT_shader_explicit_arithmetic_types_float16: require
+#extension GL_KHR_memory_scope_semantics: require
+#extension GL_EXT_shader_explicit_arithmetic_types: require
+#extension GL_KHR_cooperative_matrix: require
+
+layout (constant_id = 0) const int loop = 1;
+layout (constant_id = 1) const int M = 1;
+layout (constant_id = 2) const int N = 1;
+layout (constant_id = 3) const int K = 1;
+
+layout (binding = 0) writeonly buffer c_blob { float c_blob_data[]; };
+
+void main()
+{
+    const uint gx = gl_GlobalInvocationID.x;
+    const uint lx = gl_LocalInvocationID.x;
+
+    coopmat<FP8T, gl_ScopeSubgroup, M, K, gl_MatrixUseA> a = coopmat<FP8T, gl_ScopeSubgroup, M, K, gl_MatrixUseA>(float(gx));
+    coopmat<FP8T, gl_ScopeSubgroup, K, N, gl_MatrixUseB> b = coopmat<FP8T, gl_ScopeSubgroup, K, N, gl_MatrixUseB>(float(lx));
+
+    coopmat<float16_t, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator> c = coopmat<float16_t, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator>(float(gx));
+
+    for (int i = 0; i < loop; i++)
+    {
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+    }
+
+    coopMatStore(c, c_blob_data, gx * (M * N) / 2, N / 2, gl_CooperativeMatrixLayoutRowMajor);
+}
+)";
+
+static const char glsl_fp8_fp16_matrix_dual_khr_data[] = R"(
+#extension GL_EXT_shader_explicit_arithmetic_types_float16: require
+#extension GL_KHR_memory_scope_semantics: require
+#extension GL_EXT_shader_explicit_arithmetic_types: require
+#extension GL_KHR_cooperative_matrix: require
+
+layout (constant_id = 0) const int loop = 1;
+layout (constant_id = 1) const int M = 1;
+layout (constant_id = 2) const int N = 1;
+layout (constant_id = 3) const int K = 1;
+
+layout (binding = 0) writeonly buffer c_blob { float c_blob_data[]; };
+
+void main()
+{
+    const uint gx = gl_GlobalInvocationID.x;
+    const uint lx = gl_LocalInvocationID.x;
+
+    coopmat<FP8T, gl_ScopeSubgroup, M, K, gl_MatrixUseA> a = coopmat<FP8T, gl_ScopeSubgroup, M, K, gl_MatrixUseA>(float(gx));
+    coopmat<FP8T, gl_ScopeSubgroup, K, N, gl_MatrixUseB> b = coopmat<FP8T, gl_ScopeSubgroup, K, N, gl_MatrixUseB>(float(lx));
+
+    coopmat<float16_t, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator> c0 = coopmat<float16_t, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator>(float(gx));
+    coopmat<float16_t, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator> c1 = coopmat<float16_t, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator>(float(lx));
+
+    for (int i = 0; i < loop; i++)
+    {
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+    }
+
+    c0 = c0 + c1;
+    coopMatStore(c0, c_blob_data, gx * (M * N) / 2, N / 2, gl_CooperativeMatrixLayoutRowMajor);
+}
+)";
+
+static const char glsl_fp8_fp32_matrix_khr_data[] = R"(
+#extension GL_EXT_shader_explicit_arithmetic_types_float16: require
+#extension GL_KHR_memory_scope_semantics: require
+#extension GL_EXT_shader_explicit_arithmetic_types: require
+#extension GL_KHR_cooperative_matrix: require
+
+layout (constant_id = 0) const int loop = 1;
+layout (constant_id = 1) const int M = 1;
+layout (constant_id = 2) const int N = 1;
+layout (constant_id = 3) const int K = 1;
+
+layout (binding = 0) writeonly buffer c_blob { float c_blob_data[]; };
+
+void main()
+{
+    const uint gx = gl_GlobalInvocationID.x;
+    const uint lx = gl_LocalInvocationID.x;
+
+    coopmat<FP8T, gl_ScopeSubgroup, M, K, gl_MatrixUseA> a = coopmat<FP8T, gl_ScopeSubgroup, M, K, gl_MatrixUseA>(float(gx));
+    coopmat<FP8T, gl_ScopeSubgroup, K, N, gl_MatrixUseB> b = coopmat<FP8T, gl_ScopeSubgroup, K, N, gl_MatrixUseB>(float(lx));
+
+    coopmat<float, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator> c = coopmat<float, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator>(float(gx));
+
+    for (int i = 0; i < loop; i++)
+    {
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+        c = coopMatMulAdd(a, b, c);
+    }
+
+    coopMatStore(c, c_blob_data, gx * (M * N), N, gl_CooperativeMatrixLayoutRowMajor);
+}
+)";
+
+static const char glsl_fp8_fp32_matrix_dual_khr_data[] = R"(
+#extension GL_EXT_shader_explicit_arithmetic_types_float16: require
+#extension GL_KHR_memory_scope_semantics: require
+#extension GL_EXT_shader_explicit_arithmetic_types: require
+#extension GL_KHR_cooperative_matrix: require
+
+layout (constant_id = 0) const int loop = 1;
+layout (constant_id = 1) const int M = 1;
+layout (constant_id = 2) const int N = 1;
+layout (constant_id = 3) const int K = 1;
+
+layout (binding = 0) writeonly buffer c_blob { float c_blob_data[]; };
+
+void main()
+{
+    const uint gx = gl_GlobalInvocationID.x;
+    const uint lx = gl_LocalInvocationID.x;
+
+    coopmat<FP8T, gl_ScopeSubgroup, M, K, gl_MatrixUseA> a = coopmat<FP8T, gl_ScopeSubgroup, M, K, gl_MatrixUseA>(float(gx));
+    coopmat<FP8T, gl_ScopeSubgroup, K, N, gl_MatrixUseB> b = coopmat<FP8T, gl_ScopeSubgroup, K, N, gl_MatrixUseB>(float(lx));
+
+    coopmat<float, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator> c0 = coopmat<float, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator>(float(gx));
+    coopmat<float, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator> c1 = coopmat<float, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator>(float(lx));
+
+    for (int i = 0; i < loop; i++)
+    {
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+        c0 = coopMatMulAdd(a, b, c0);
+        c1 = coopMatMulAdd(a, b, c1);
+    }
+
+    c0 = c0 + c1;
+    coopMatStore(c0, c_blob_data, gx * (M * N), N, gl_CooperativeMatrixLayoutRowMajor);
+}
+)";
+
+// one generated peak kernel, the element type and the op follow from arithmetic_type
+// fp32 fp16 fp64 int32 int16 run a * c + b on scalar or vec4, int8 runs packed dotprod and bf16 runs vec4 dot
+struct vkpeak_peak_desc
+{
+    int arithmetic_type;    // 0/1/2/3/4/5/6 = fp32 fp16 fp64 int32 int16 int8 bf16
+    int packing_type;       // 1/4 = scalar vec4, vec4 only for int8 and bf16
+    int unroll;             // statements per loop
+    int chains;             // independent accumulators, the statements go round robin over them
+};
+
+// the glsl and the exact op count of one descriptor, -1 for an invalid combination
+// unroll 16 with 1 and 2 chains are the single and dual kernels every peak test times
+static int build_peak_kernel(const vkpeak_peak_desc& desc, vkpeak_kernel& kernel)
+{
+    const int arithmetic_type = desc.arithmetic_type;
+    const int chains = desc.chains;
+    const bool vec4 = desc.packing_type == 4;
+
+    if (arithmetic_type < 0 || arithmetic_type > 6)
+        return -1;
+    if (desc.packing_type != 1 && desc.packing_type != 4)
+        return -1;
+    if ((arithmetic_type == 5 || arithmetic_type == 6) && !vec4)
+        return -1;
+    if (desc.unroll < 1 || chains < 1 || chains > desc.unroll)
+        return -1;
+
+    // T is the accumulator type, cast converts the reduced accumulator for the store
+    std::string T;
+    std::string buffer_type = "int";
+    std::string header;
+    std::string cast;
+    if (arithmetic_type == 0 || arithmetic_type == 1)
+    {
+        T = vec4 ? "afpvec4" : "afp";
+        buffer_type = "float";
+        cast = "sfp";
+    }
+    else if (arithmetic_type == 2)
+    {
+        T = vec4 ? "dvec4" : "double";
+        buffer_type = "double";
+    }
+    else if (arithmetic_type == 3)
+    {
+        T = vec4 ? "ivec4" : "int";
+    }
+    else if (arithmetic_type == 4)
+    {
+        header = "#extension GL_EXT_shader_explicit_arithmetic_types_int16: require\n\n";
+        T = vec4 ? "i16vec4" : "int16_t";
+        cast = "int";
+    }
+    else if (arithmetic_type == 5)
+    {
+        header = "#extension GL_EXT_integer_dot_product: require\n\n";
+        T = "int";
+    }
+    else // if (arithmetic_type == 6)
+    {
+        header = "#extension GL_EXT_shader_explicit_arithmetic_types : require\n#extension GL_EXT_bfloat16: require\n\n";
+        T = "bfloat16_t";
+        buffer_type = "float";
+    }
+
+    // c for a single chain, c0 c1 ... otherwise, the same for the bf16 operands a
+    std::vector<std::string> c(chains);
+    std::vector<std::string> a(chains);
+    for (int k = 0; k < chains; k++)
+    {
+        char name[16];
+        sprintf(name, chains == 1 ? "c" : "c%d", k);
+        c[k] = name;
+        sprintf(name, chains == 1 ? "a" : "a%d", k);
+        a[k] = name;
+    }
+
+    char line[256];
+
+    std::string glsl = "\n#version 450\n\n" + header;
+
+    glsl += "layout (constant_id = 0) const int loop = 1;\n\n";
+    glsl += "layout (binding = 0) writeonly buffer c_blob { " + buffer_type + " c_blob_data[]; };\n\n";
+    glsl += "void main()\n{\n";
+    glsl += "    const uint gx = gl_GlobalInvocationID.x;\n";
+    glsl += "    const uint lx = gl_LocalInvocationID.x;\n\n";
+
+    // gx lx for the first two chains like the hand written kernels, distinct values for the rest
+    for (int k = 0; k < chains; k++)
+    {
+        if (k < 2)
+            sprintf(line, "    %s %s = %s(%s);\n", T.c_str(), c[k].c_str(), T.c_str(), k == 0 ? "gx" : "lx");
+        else
+            sprintf(line, "    %s %s = %s(gx + %du);\n", T.c_str(), c[k].c_str(), T.c_str(), k);
+        glsl += line;
+    }
+    glsl += "\n";
+
+    if (arithmetic_type == 5)
+    {
+        glsl += "    int a = int(gx);\n";
+        glsl += "    int b = int(lx);\n";
+    }
+    else if (arithmetic_type == 6)
+    {
+        for (int k = 0; k < chains; k++)
+        {
+            if (k == 0)
+                sprintf(line, "    u16vec4 %s = uint16_t(gx) + u16vec4(0,1,2,3);\n", a[k].c_str());
+            else
+                sprintf(line, "    u16vec4 %s = uint16_t(gx) + u16vec4(%d,%d,%d,%d);\n", a[k].c_str(), k * 10, k * 10 + 11, k * 10 + 22, k * 10 + 33);
+            glsl += line;
+        }
+        glsl += "    bf16vec4 b = uintBitsToBFloat16EXT(uint16_t(lx) + u16vec4(2,3,5,7));\n";
+    }
+    else
+    {
+        const std::string b = chains == 1 ? T + "(lx)" : c[1];
+
+        if (vec4)
+        {
+            glsl += "    " + T + " a = " + c[0] + " + " + T + "(0,1,2,-3);\n";
+            glsl += "    " + T + " b = " + b + " + " + T + "(2,3,5,-7);\n";
+        }
+        else
+        {
+            glsl += "    " + T + " a = " + c[0] + ";\n";
+            glsl += "    " + T + " b = " + b + ";\n";
+        }
+    }
+
+    glsl += "\n    for (int i = 0; i < loop; i++)\n    {\n";
+    for (int j = 0; j < desc.unroll; j++)
+    {
+        const char* ck = c[j % chains].c_str();
+        const char* ak = a[j % chains].c_str();
+
+        if (arithmetic_type == 5)
+        {
+            sprintf(line, "        %s = dotPacked4x8AccSatEXT(a, b, %s);\n", ck, ck);
+        }
+        else if (arithmetic_type == 6)
+        {
+            // feed the result back into a rotating lane of the operand
+            sprintf(line, "        %s = dot(uintBitsToBFloat16EXT(%s), b);\n        %s.%c = bfloat16BitsToUintEXT(%s);\n", ck, ak, ak, "xyzw"[j % 4], ck);
+        }
+        else
+        {
+            sprintf(line, "        %s = a * %s + b;\n", ck, ck);
+        }
+        glsl += line;
+    }
+    glsl += "    }\n\n";
+
+    if (arithmetic_type == 6)
+    {
+        // no bf16 arithmetic, sum in fp32
+        glsl += "    c_blob_data[gx] = float(" + c[0] + ")";
+        for (int k = 1; k < chains; k++)
+        {
+            glsl += " + float(" + c[k] + ")";
+        }
+        glsl += ";\n";
+    }
+    else
+    {
+        for (int k = 1; k < chains; k++)
+        {
+            glsl += "    " + c[0] + " = " + c[0] + " + " + c[k] + ";\n";
+        }
+        std::string value = c[0];
+        if (vec4 && arithmetic_type != 5)
+            value = "(" + c[0] + "[0] + " + c[0] + "[1]) + (" + c[0] + "[2] + " + c[0] + "[3])";
+        if (!cast.empty())
+            value = cast + "(" + value + ")";
+
+        glsl += "    c_blob_data[gx] = " + value + ";\n";
+    }
+
+    glsl += "}\n";
+
+    kernel.glsl = glsl;
+
+    // fma and the 4 wide dots are 2 ops per lane, plus chains - 1 adds to reduce the accumulators
+    const int width = vec4 ? 4 : 1;
+    kernel.ops_per_loop = desc.unroll * 2 * width;
+    kernel.ops_tail = (chains - 1) * width;
+
+    return 0;
+}
+
+// everything one peak test needs except the work buffer binding, -1 if the combination is not supported
+// unroll statements per loop, chains = 0 times the single and dual chain kernels, otherwise one kernel with chains accumulators
+static int prepare_peak(ncnn::VulkanDevice* vkdev, int count_mb, int storage_type, int arithmetic_type, int packing_type, int unroll, int chains, vkpeak_workload& workload)
+{
+    if (!vkdev->info.support_fp16_storage() && storage_type == 1)
+    {
+        return -1;
+    }
+    if (!vkdev->info.support_fp16_storage() && storage_type == 4)
+    {
+        return -1;
+    }
+    if (!vkdev->info.support_fp16_arithmetic() && arithmetic_type == 1)
+    {
+        return -1;
+    }
+    if (!vkdev->info.support_fp16_arithmetic() && arithmetic_type == 4)
+    {
+        return -1;
+    }
+    if (!vkdev->info.support_int8_arithmetic() && arithmetic_type == 5)
+    {
+        return -1;
+    }
+    if (!vkdev->info.support_cooperative_matrix() && packing_type == 256)
+    {
+        return -1;
+    }
+
+    // check shader fp64 feature
+    bool has_shader_fp64 = vkdev->info.physicalDevicefeatures().shaderFloat64;
+    if (!has_shader_fp64 && (storage_type == 2 || arithmetic_type == 2))
+    {
+        return -1;
+    }
+
+    // check shader int8 dotprod feature
+    bool has_shader_int8_dotprod = vkdev->info.queryShaderIntegerDotProductFeatures().shaderIntegerDotProduct;
+    if (!has_shader_int8_dotprod && (arithmetic_type == 5 && packing_type == 4))
+    {
+        return -1;
+    }
+
+    // check shader bf16 feature
+    bool has_shader_bf16 = vkdev->info.queryShaderBfloat16Features().shaderBFloat16Type;
+    if (!has_shader_bf16 && (arithmetic_type == 6))
+    {
+        return -1;
+    }
+
+    // check shader bf16 dotprod feature
+    bool has_shader_bf16_dotprod = vkdev->info.queryShaderBfloat16Features().shaderBFloat16DotProduct;
+    if (!has_shader_bf16_dotprod && (arithmetic_type == 6 && packing_type == 4))
+    {
+        return -1;
+    }
+
+    // check shader bf16 cooperative matrix feature
+    bool has_shader_bf16_matrix = vkdev->info.queryShaderBfloat16Features().shaderBFloat16CooperativeMatrix;
+    if (!has_shader_bf16_matrix && (arithmetic_type == 6 && packing_type == 256))
+    {
+        return -1;
+    }
+
+    // check shader fp8 feature
+    bool has_shader_fp8 = vkdev->info.support_VK_EXT_shader_float8() && vkdev->info.queryShaderFloat8Features().shaderFloat8;
+    if (!has_shader_fp8 && (arithmetic_type == 7 || arithmetic_type == 8))
+    {
+        return -1;
+    }
+
+    // check shader fp8 cooperative matrix feature
+    bool has_shader_fp8_matrix = vkdev->info.support_VK_EXT_shader_float8() && vkdev->info.queryShaderFloat8Features().shaderFloat8CooperativeMatrix;
+    if (!has_shader_fp8_matrix && ((arithmetic_type == 7 || arithmetic_type == 8) && packing_type == 256))
+    {
+        return -1;
+    }
+
+    ncnn::Option opt;
+    opt.use_vulkan_compute = true;
+    opt.use_fp16_packed = storage_type == 1;
+    opt.use_fp16_storage = storage_type == 1 || storage_type == 4;
+    opt.use_fp16_arithmetic = arithmetic_type == 1;
+
+    int buffer_size = vkpeak_buffer_size(vkdev, count_mb);
+
+    int elemsize = 0;
+    if (storage_type == 0 || storage_type == 3)
+    {
+        // fp32 / int32
+        elemsize = 4;
+    }
+    else if (storage_type == 1 || storage_type == 4)
+    {
+        // fp16 / int16
+        elemsize = 2;
+    }
+    else if (storage_type == 2)
+    {
+        // fp64
+        elemsize = 8;
+    }
+    else if (storage_type == 5)
+    {
+        // int8
+        elemsize = 1;
+    }
+
+    if (elemsize == 0)
+    {
+        // no kernel stores this type
+        return -1;
+    }
+
+    const int subgroup_size = std::max(1, (int)vkdev->info.subgroup_size());
+
+    int local_size_x = vkpeak_local_size(vkdev, std::min(128, subgroup_size));
+    if (packing_type == 256)
+    {
+        // matrix on subgroup, every subgroup of the workgroup runs its own matrix
+        local_size_x = std::max(vkpeak_local_size(vkdev, subgroup_size) / subgroup_size, 1) * subgroup_size;
+    }
+
+    int M = 1;
+    int N = 1;
+    int K = 1;
+    bool use_fp16_fp32_matrix = false;
+    bool use_bf16_fp32_matrix = false;
+    bool use_fp8_fp32_matrix = false;
+    if (packing_type == 256)
+    {
+        bool mnk_found = false;
+
+        if (arithmetic_type == 1)
+        {
+            if (vkdev->info.support_VK_KHR_cooperative_matrix())
+            {
+                const std::vector<VkCooperativeMatrixPropertiesKHR>& properties = vkdev->info.queryCooperativeMatrixProperties();
+
+                {
+                    // find fp16 * fp16 => fp16
+                    for (uint32_t j = 0; j < properties.size(); j++)
+                    {
+                        const VkCooperativeMatrixPropertiesKHR& cmp = properties[j];
+
+                        if (cmp.AType == VK_COMPONENT_TYPE_FLOAT16_KHR && cmp.BType == VK_COMPONENT_TYPE_FLOAT16_KHR
+                            && cmp.CType == VK_COMPONENT_TYPE_FLOAT16_KHR && cmp.ResultType == VK_COMPONENT_TYPE_FLOAT16_KHR
+                            && cmp.scope == VK_SCOPE_SUBGROUP_KHR)
+                        {
+                            M = cmp.MSize;
+                            N = cmp.NSize;
+                            K = cmp.KSize;
+                            mnk_found = true;
+                            break;
+                        }
+                    }
+                }
+
+                if (!mnk_found)
+                {
+                    // find fp16 * fp16 => fp32
+                    for (uint32_t j = 0; j < properties.size(); j++)
+                    {
+                        const VkCooperativeMatrixPropertiesKHR& cmp = properties[j];
+
+                        if (cmp.AType == VK_COMPONENT_TYPE_FLOAT16_KHR && cmp.BType == VK_COMPONENT_TYPE_FLOAT16_KHR
+                            && cmp.CType == VK_COMPONENT_TYPE_FLOAT32_KHR && cmp.ResultType == VK_COMPONENT_TYPE_FLOAT32_KHR
+                            && cmp.scope == VK_SCOPE_SUBGROUP_KHR)
+                        {
+                            M = cmp.MSize;
+                            N = cmp.NSize;
+                            K = cmp.KSize;
+                            mnk_found = true;
+                            use_fp16_fp32_matrix = true;
+                            break;
+                        }
+                    }
+                }
+            }
+            else // if (vkdev->info.support_VK_NV_cooperative_matrix())
+            {
+                const std::vector<VkCooperativeMatrixPropertiesNV>& properties = vkdev->info.queryCooperativeMatrixPropertiesNV();
+
+                {
+                    // find fp16 * fp16 => fp16
+                    for (uint32_t j = 0; j < properties.size(); j++)
+                    {
+                        const VkCooperativeMatrixPropertiesNV& cmp = properties[j];
+
+                        if (cmp.AType == VK_COMPONENT_TYPE_FLOAT16_NV && cmp.BType == VK_COMPONENT_TYPE_FLOAT16_NV
+                            && cmp.CType == VK_COMPONENT_TYPE_FLOAT16_NV && cmp.DType == VK_COMPONENT_TYPE_FLOAT16_NV
+                            && cmp.scope == VK_SCOPE_SUBGROUP_NV)
+                        {
+                            M = cmp.MSize;
+                            N = cmp.NSize;
+                            K = cmp.KSize;
+                            mnk_found = true;
+                            break;
+                        }
+                    }
+                }
+
+                if (!mnk_found)
+                {
+                    // find fp16 * fp16 => fp32
+                    for (uint32_t j = 0; j < properties.size(); j++)
+                    {
+                        const VkCooperativeMatrixPropertiesNV& cmp = properties[j];
+
+                        if (cmp.AType == VK_COMPONENT_TYPE_FLOAT16_NV && cmp.BType == VK_COMPONENT_TYPE_FLOAT16_NV
+                            && cmp.CType == VK_COMPONENT_TYPE_FLOAT32_NV && cmp.DType == VK_COMPONENT_TYPE_FLOAT32_NV
+                            && cmp.scope == VK_SCOPE_SUBGROUP_NV)
+                        {
+                            M = cmp.MSize;
+                            N = cmp.NSize;
+                            K = cmp.KSize;
+                            mnk_found = true;
+                            use_fp16_fp32_matrix = true;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+
+        if (arithmetic_type == 5)
+        {
+            if (vkdev->info.support_VK_KHR_cooperative_matrix())
+            {
+                const std::vector<VkCooperativeMatrixPropertiesKHR>& properties = vkdev->info.queryCooperativeMatrixProperties();
+
+                // find int8 * int8 => int32
+                for (uint32_t j = 0; j < properties.size(); j++)
+                {
+                    const VkCooperativeMatrixPropertiesKHR& cmp = properties[j];
+
+                    if (cmp.AType == VK_COMPONENT_TYPE_SINT8_KHR && cmp.BType == VK_COMPONENT_TYPE_SINT8_KHR
+                        && cmp.CType == VK_COMPONENT_TYPE_SINT32_KHR && cmp.ResultType == VK_COMPONENT_TYPE_SINT32_KHR
+                        && cmp.scope == VK_SCOPE_SUBGROUP_KHR)
+                    {
+                        M = cmp.MSize;
+                        N = cmp.NSize;
+                        K = cmp.KSize;
+                        mnk_found = true;
+                        break;
+                    }
+                }
+            }
+            else // if (vkdev->info.support_VK_NV_cooperative_matrix())
+            {
+                const std::vector<VkCooperativeMatrixPropertiesNV>& properties = vkdev->info.queryCooperativeMatrixPropertiesNV();
+
+                // find int8 * int8 => int32
+                for (uint32_t j = 0; j < properties.size(); j++)
+                {
+                    const VkCooperativeMatrixPropertiesNV& cmp = properties[j];
+
+                    if (cmp.AType == VK_COMPONENT_TYPE_SINT8_NV && cmp.BType == VK_COMPONENT_TYPE_SINT8_NV
+                        && cmp.CType == VK_COMPONENT_TYPE_SINT32_NV && cmp.DType == VK_COMPONENT_TYPE_SINT32_NV
+                        && cmp.scope == VK_SCOPE_SUBGROUP_NV)
+                    {
+                        M = cmp.MSize;
+                        N = cmp.NSize;
+                        K = cmp.KSize;
+                        mnk_found = true;
+                        break;
+                    }
+                }
+            }
+        }
+
+        if (arithmetic_type == 6)
+        {
+            if (vkdev->info.support_VK_KHR_cooperative_matrix())
+            {
+                const std::vector<VkCooperativeMatrixPropertiesKHR>& properties = vkdev->info.queryCooperativeMatrixProperties();
+
+                {
+                    // find bf16 * bf16 => bf16
+                    for (uint32_t j = 0; j < properties.size(); j++)
+                    {
+                        const VkCooperativeMatrixPropertiesKHR& cmp = properties[j];
+
+                        if (cmp.AType == VK_COMPONENT_TYPE_BFLOAT16_KHR && cmp.BType == VK_COMPONENT_TYPE_BFLOAT16_KHR
+                            && cmp.CType == VK_COMPONENT_TYPE_BFLOAT16_KHR && cmp.ResultType == VK_COMPONENT_TYPE_BFLOAT16_KHR
+                            && cmp.scope == VK_SCOPE_SUBGROUP_KHR)
+                        {
+                            M = cmp.MSize;
+                            N = cmp.NSize;
+                            K = cmp.KSize;
+                            mnk_found = true;
+                            break;
+                        }
+                    }
+                }
+
+                if (!mnk_found)
+                {
+                    // find bf16 * bf16 => fp32
+                    for (uint32_t j = 0; j < properties.size(); j++)
+                    {
+                        const VkCooperativeMatrixPropertiesKHR& cmp = properties[j];
+
+                        if (cmp.AType == VK_COMPONENT_TYPE_BFLOAT16_KHR && cmp.BType == VK_COMPONENT_TYPE_BFLOAT16_KHR
+                            && cmp.CType == VK_COMPONENT_TYPE_FLOAT32_KHR && cmp.ResultType == VK_COMPONENT_TYPE_FLOAT32_KHR
+                            && cmp.scope == VK_SCOPE_SUBGROUP_KHR)
+                        {
+                            M = cmp.MSize;
+                            N = cmp.NSize;
+                            K = cmp.KSize;
+                            mnk_found = true;
+                            use_bf16_fp32_matrix = true;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+
+        if (arithmetic_type == 7 || arithmetic_type == 8)
+        {
+            if (vkdev->info.support_VK_KHR_cooperative_matrix())
+            {
+                const std::vector<VkCooperativeMatrixPropertiesKHR>& properties = vkdev->info.queryCooperativeMatrixProperties();
+
+                const VkComponentTypeKHR fp8_type = arithmetic_type == 7 ? VK_COMPONENT_TYPE_FLOAT8_E4M3_EXT : VK_COMPONENT_TYPE_FLOAT8_E5M2_EXT;
+
+                if (vkdev->info.support_fp16_arithmetic())
+                {
+                    // find fp8 * fp8 => fp16
+                    for (uint32_t j = 0; j < properties.size(); j++)
+                    {
+                        const VkCooperativeMatrixPropertiesKHR& cmp = properties[j];
+
+                        if (cmp.AType == fp8_type && cmp.BType == fp8_type
+                            && cmp.CType == VK_COMPONENT_TYPE_FLOAT16_KHR && cmp.ResultType == VK_COMPONENT_TYPE_FLOAT16_KHR
+                            && cmp.scope == VK_SCOPE_SUBGROUP_KHR)
+                        {
+                            M = cmp.MSize;
+                            N = cmp.NSize;
+                            K = cmp.KSize;
+                            mnk_found = true;
+                            break;
+                        }
+                    }
+                }
+
+                if (!mnk_found)
+                {
+                    // find fp8 * fp8 => fp32
+                    for (uint32_t j = 0; j < properties.size(); j++)
+                    {
+                        const VkCooperativeMatrixPropertiesKHR& cmp = properties[j];
+
+                        if (cmp.AType == fp8_type && cmp.BType == fp8_type
+                            && cmp.CType == VK_COMPONENT_TYPE_FLOAT32_KHR && cmp.ResultType == VK_COMPONENT_TYPE_FLOAT32_KHR
+                            && cmp.scope == VK_SCOPE_SUBGROUP_KHR)
+                        {
+                            M = cmp.MSize;
+                            N = cmp.NSize;
+                            K = cmp.KSize;
+                            mnk_found = true;
+                            use_fp8_fp32_matrix = true;
+                            break;
+                        }
+                    }
+                }
+            }
+        }
+
+        if (!mnk_found)
+        {
+            // no supported component type
+            return -1;
+        }
+    }
+
+    int max_invocation_count = buffer_size / elemsize;
+    // make max_invocation_count be multiple of local_size_x
+    max_invocation_count = std::max(max_invocation_count / local_size_x, 1) * local_size_x;
+    if (packing_type == 256)
+    {
+        if (use_fp16_fp32_matrix || use_bf16_fp32_matrix || use_fp8_fp32_matrix)
+            max_invocation_count = std::max(max_invocation_count / (M * N) / 2, 1);
+        else
+            max_invocation_count = std::max(max_invocation_count / (M * N), 1);
+    }
+
+    // start with little works
+    int invocation_count = std::max(max_invocation_count / 32, 8);
+
+    std::vector<ncnn::vk_specialization_type> specializations(1);
+
+    std::vector<vkpeak_kernel> kernels;
+
+    if (packing_type == 256)
+    {
+        // matrix kernels keep one accumulator per subgroup
+        if (unroll != 16 || chains != 0)
+            return -1;
+
+        // loop M N K
+        specializations.resize(4);
+        specializations[1].i = M;
+        specializations[2].i = N;
+        specializations[3].i = K;
+
+        vkpeak_kernel kernel;
+        vkpeak_kernel kernel_dual;
+
+        // -1 for omit the tail '\0'
+        if (arithmetic_type == 5)
+        {
+            if (vkdev->info.support_VK_KHR_cooperative_matrix())
+            {
+                kernel.glsl.assign(glsl_int8_matrix_khr_data, sizeof(glsl_int8_matrix_khr_data) - 1);
+                kernel_dual.glsl.assign(glsl_int8_matrix_dual_khr_data, sizeof(glsl_int8_matrix_dual_khr_data) - 1);
+            }
+            else
+            {
+                kernel.glsl.assign(glsl_int8_matrix_nv_data, sizeof(glsl_int8_matrix_nv_data) - 1);
+                kernel_dual.glsl.assign(glsl_int8_matrix_dual_nv_data, sizeof(glsl_int8_matrix_dual_nv_data) - 1);
+            }
+        }
+        else if (arithmetic_type == 7 || arithmetic_type == 8)
+        {
+            const std::string header = arithmetic_type == 7 ? glsl_fp8_e4m3_header : glsl_fp8_e5m2_header;
+
+            if (use_fp8_fp32_matrix)
+            {
+                kernel.glsl = header + glsl_fp8_fp32_matrix_khr_data;
+                kernel_dual.glsl = header + glsl_fp8_fp32_matrix_dual_khr_data;
+            }
+            else
+            {
+                kernel.glsl = header + glsl_fp8_fp16_matrix_khr_data;
+                kernel_dual.glsl = header + glsl_fp8_fp16_matrix_dual_khr_data;
+            }
+        }
+        else if (arithmetic_type == 6)
+        {
+            if (use_bf16_fp32_matrix)
+            {
+                kernel.glsl.assign(glsl_bf16_fp32_matrix_khr_data, sizeof(glsl_bf16_fp32_matrix_khr_data) - 1);
+                kernel_dual.glsl.assign(glsl_bf16_fp32_matrix_dual_khr_data, sizeof(glsl_bf16_fp32_matrix_dual_khr_data) - 1);
+            }
+            else
+            {
+                kernel.glsl.assign(glsl_bf16_matrix_khr_data, sizeof(glsl_bf16_matrix_khr_data) - 1);
+                kernel_dual.glsl.assign(glsl_bf16_matrix_dual_khr_data, sizeof(glsl_bf16_matrix_dual_khr_data) - 1);
+            }
+        }
+        else // if (arithmetic_type == 1)
+        {
+            if (vkdev->info.support_VK_KHR_cooperative_matrix())
+            {
+                if (use_fp16_fp32_matrix)
+                {
+                    kernel.glsl.assign(glsl_fp16_fp32_matrix_khr_data, sizeof(glsl_fp16_fp32_matrix_khr_data) - 1);
+                    kernel_dual.glsl.assign(glsl_fp16_fp32_matrix_dual_khr_data, sizeof(glsl_fp16_fp32_matrix_dual_khr_data) - 1);
+                }
+                else
+                {
+                    kernel.glsl.assign(glsl_fp16_matrix_khr_data, sizeof(glsl_fp16_matrix_khr_data) - 1);
+                    kernel_dual.glsl.assign(glsl_fp16_matrix_dual_khr_data, sizeof(glsl_fp16_matrix_dual_khr_data) - 1);
+                }
+            }
+            else
+            {
+                if (use_fp16_fp32_matrix)
+                {
+                    kernel.glsl.assign(glsl_fp16_fp32_matrix_nv_data, sizeof(glsl_fp16_fp32_matrix_nv_data) - 1);
+                    kernel_dual.glsl.assign(glsl_fp16_fp32_matrix_dual_nv_data, sizeof(glsl_fp16_fp32_matrix_dual_nv_data) - 1);
+                }
+                else
+                {
+                    kernel.glsl.assign(glsl_fp16_matrix_nv_data, sizeof(glsl_fp16_matrix_nv_data) - 1);
+                    kernel_dual.glsl.assign(glsl_fp16_matrix_dual_nv_data, sizeof(glsl_fp16_matrix_dual_nv_data) - 1);
+                }
+            }
+        }
+
+        const double scale = (double)(M * N * K) / subgroup_size;
+
+        kernel.ops_per_loop = 16 * 2 * scale;
+        kernel.ops_tail = 0;
+
+        // dual issue is faster
+        kernel_dual.ops_per_loop = 16 * 2 * scale;
+        kernel_dual.ops_tail = 1 * scale; // +1 for the tail c0+c1
+
+        kernels.push_back(kernel);
+        kernels.push_back(kernel_dual);
+    }
+    else
+    {
+        // the single and dual chain kernels, or the requested chain count only
+        std::vector<int> chain_counts;
+        if (chains == 0)
+        {
+            chain_counts.push_back(1);
+            chain_counts.push_back(2);
+        }
+        else
+        {
+            chain_counts.push_back(chains);
+        }
+
+        for (size_t i = 0; i < chain_counts.size(); i++)
+        {
+            vkpeak_peak_desc desc;
+            desc.arithmetic_type = arithmetic_type;
+            desc.packing_type = packing_type;
+            desc.unroll = unroll;
+            desc.chains = chain_counts[i];
+
+            vkpeak_kernel kernel;
+            int ret = build_peak_kernel(desc, kernel);
+            if (ret != 0)
+            {
+                // no kernel for this combination
+                return -1;
+            }
+
+            kernels.push_back(kernel);
+        }
+    }
+
+    workload.vkdev = vkdev;
+    workload.opt = opt;
+    workload.kernels = kernels;
+    workload.specializations = specializations;
+    workload.local_size_x = local_size_x;
+    workload.invocation_count = invocation_count;
+    workload.max_invocation_count = max_invocation_count;
+    workload.split_queues = true;
+
+    return 0;
+}
+
+// bind the work buffer and run a prepared peak test
+static double run_peak(vkpeak_workload& workload, int loop, int count_mb, int cmd_loop)
+{
+    ncnn::VulkanDevice* vkdev = workload.vkdev;
+
+    ncnn::VkAllocator* allocator = vkdev->acquire_blob_allocator();
+
+    int buffer_size = vkpeak_buffer_size(vkdev, count_mb);
+
+    ncnn::VkMat c(buffer_size, (size_t)1u, 1, allocator);
+
+    workload.bindings.push_back(c);
+
+    double max_gflops = vkpeak_run(workload, loop, cmd_loop);
+
+    // vkpeak_run destroyed the prepared pipelines
+    workload.bindings.clear();
+    workload.pipelines.clear();
+
+    vkdev->reclaim_blob_allocator(allocator);
+
+    return max_gflops;
+}
+
+double vkpeak(int loop, int count_mb, int cmd_loop, int storage_type, int arithmetic_type, int packing_type)
+{
+    ncnn::VulkanDevice* vkdev = vkpeak_get_device();
+
+    if (!vkdev)
+    {
+        return 0;
+    }
+
+    vkpeak_workload workload;
+    int ret = prepare_peak(vkdev, count_mb, storage_type, arithmetic_type, packing_type, 16, 0, workload);
+    if (ret != 0)
+    {
+        return 0;
+    }
+
+    return run_peak(workload, loop, count_mb, cmd_loop);
+}
+
+double vkpeak_custom(int loop, int count_mb, int cmd_loop, int storage_type, int arithmetic_type, int packing_type, int unroll, int chains)
+{
+    ncnn::VulkanDevice* vkdev = vkpeak_get_device();
+
+    if (!vkdev)
+    {
+        return 0;
+    }
+
+    if (unroll < 1 || chains < 1)
+    {
+        return 0;
+    }
+
+    vkpeak_workload workload;
+    int ret = prepare_peak(vkdev, count_mb, storage_type, arithmetic_type, packing_type, unroll, chains, workload);
+    if (ret != 0)
+    {
+        return 0;
+    }
+
+    return run_peak(workload, loop, count_mb, cmd_loop);
+}
+
+double vkpeak_ilp(int loop, int count_mb, int cmd_loop, int storage_type, int arithmetic_type, int packing_type, int chains)
+{
+    if (chains > 16)
+    {
+        return 0;
+    }
+
+    return vkpeak_custom(loop, count_mb, cmd_loop, storage_type, arithmetic_type, packing_type, 16, chains);
+}
+
+struct vkpeak_prepare_task
+{
+    std::vector<vkpeak_workload>* workloads;
+    int loop;
+
+    // next workload to take, shared by all workers
+    ncnn::Mutex* lock;
+    size_t* next;
+};
+
+static void* prepare_worker(void* args)
+{
+    vkpeak_prepare_task* task = (vkpeak_prepare_task*)args;
+
+    for (;;)
+    {
+        size_t i;
+        {
+            ncnn::MutexLockGuard g(*task->lock);
+            i = (*task->next)++;
+        }
+
+        if (i >= task->workloads->size())
+            break;
+
+        vkpeak_workload& workload = (*task->workloads)[i];
+        if (workload.kernels.empty())
+            continue;
+
+        // a failed prepare leaves the pipelines to the run, which reports the error
+        vkpeak_prepare(workload, task->loop);
+    }
+
+    return 0;
+}
+
+int vkpeak_sweep(int loop, int count_mb, int cmd_loop, int config_count, const int* storage_types, const int* arithmetic_types, const int* packing_types, double* results, vkpeak_stats* stats)
+{
+    ncnn::VulkanDevice* vkdev = vkpeak_get_device();
+
+    if (!vkdev)
+    {
+        return -1;
+    }
+
+    // unsupported combinations keep no kernels
+    std::vector<vkpeak_workload> workloads(config_count);
+    for (int i = 0; i < config_count; i++)
+    {
+        int ret = prepare_peak(vkdev, count_mb, storage_types[i], arithmetic_types[i], packing_types[i], 16, 0, workloads[i]);
+        if (ret != 0)
+        {
+            workloads[i] = vkpeak_workload();
+        }
+    }
+
+    // compile every shader and create every pipeline up front, glslang and the driver compiler run on all cores
+    {
+        ncnn::Mutex lock;
+        size_t next = 0;
+
+        vkpeak_prepare_task task;
+        task.workloads = &workloads;
+        task.loop = loop;
+        task.lock = &lock;
+        task.next = &next;
+
+        const int thread_count = std::max(std::min(ncnn::get_cpu_count(), config_count), 1);
+
+        std::vector<ncnn::Thread*> threads(thread_count);
+        for (int t = 0; t < thread_count; t++)
+        {
+            threads[t] = new ncnn::Thread(prepare_worker, &task);
+        }
+        for (int t = 0; t < thread_count; t++)
+        {
+            threads[t]->join();
+            delete threads[t];
+        }
+    }
+
+    // time back to back
+    for (int i = 0; i < config_count; i++)
+    {
+        results[i] = 0;
+        if (stats)
+            stats[i] = vkpeak_stats();
+
+        if (workloads[i].kernels.empty())
+            continue;
+
+        results[i] = run_peak(workloads[i], loop, count_mb, cmd_loop);
+
+        if (stats)
+            vkpeak_get_last_stats(&stats[i]);
+    }
+
+    return 0;
+}
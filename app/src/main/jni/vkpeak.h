@@ -0,0 +1,210 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef VKPEAK_H
+#define VKPEAK_H
+
+// number of vulkan devices
+int vkpeak_get_device_count();
+
+// device_index     = vulkan device for the benchmarks started on the calling thread, -1 = default device
+// threads with different devices can run benchmarks concurrently, default -1
+void vkpeak_set_device_index(int device_index);
+
+// timing_type      = 0/1           = gpu timestamp host
+// gpu timestamp falls back to host wall clock if the device cannot write timestamps on the compute queue
+// applies to every benchmark run afterwards, default 0
+void vkpeak_set_timing_type(int timing_type);
+
+// loop_type        = 0/1           = specialization constant push constant
+// the loop count of every benchmark kernel, a push constant loop cannot be unrolled by the compiler
+// and needs no new pipeline when auto-scaling doubles the loop count, default 0
+void vkpeak_set_loop_type(int loop_type);
+
+// dispatch_count   = dispatches recorded back to back in one command buffer and timed as one submit, default 1
+void vkpeak_set_dispatch_count(int dispatch_count);
+
+// queue_count      = split every dispatch over this many compute queues, submitted from one host thread each
+// capped by the compute queue count of the device, default 1
+// only the alu tests split, bandwidth shared latency and gemm always run on one queue
+void vkpeak_set_queue_count(int queue_count);
+
+// local_size_x     = workgroup size of the peak bandwidth shared subgroup and sfu kernels, capped by the device limits
+// rounded down to a multiple of the subgroup size for matrix kernels, 0 = the built-in size of each kernel, default 0
+void vkpeak_set_local_size(int local_size_x);
+
+// cv_threshold     = stop sampling once the standard error is below this fraction of the mean, 0 = fixed cmd_loop samples
+// time_budget_ms   = stop sampling after this much time even if not converged
+// with the sampler enabled every benchmark returns the median instead of the max, default 0
+void vkpeak_set_sampler(double cv_threshold, int time_budget_ms);
+
+// the samples behind the last result returned on the calling thread, in the unit of the result
+struct vkpeak_stats
+{
+    double median;
+    double p10;
+    double p90;
+    double max;
+    double cv;
+    int sample_count;
+};
+
+// the last run of the calling thread, so concurrent runs on several devices keep apart
+// another thread gets zeroed stats
+void vkpeak_get_last_stats(vkpeak_stats* stats);
+
+// duration_ms      = keep submitting the fastest kernel of every benchmark for this long and record the throughput
+// over time instead of taking cmd_loop samples, every benchmark then returns the steady state, 0 = off, default 0
+void vkpeak_set_sustained(int duration_ms);
+
+// throughput over time of the last sustained run on the calling thread, in the unit of the result
+struct vkpeak_sustained
+{
+    double peak;            // best median of 5 consecutive samples
+    double steady;          // median of the last quarter of the run
+    double steady_ratio;    // steady / peak
+    double throttle_ms;     // time the median of 5 first fell below 90% of the peak so far, -1 if never
+    int sample_count;       // samples taken, the latest 16384 are kept
+};
+
+// the last sustained run of the calling thread, like vkpeak_get_last_stats
+void vkpeak_get_sustained(vkpeak_sustained* sustained);
+
+// copy the kept samples of the last sustained run oldest first, ms since the start and throughput
+// return the number of samples copied
+int vkpeak_get_sustained_samples(double* times_ms, double* values, int max_count);
+
+// cache_dir        = existing writable directory for compiled spirv, empty or null to keep it in memory only
+void vkpeak_set_cache_dir(const char* cache_dir);
+
+// storage_type     = 0/1/2/3/4/5/6 = fp32 fp16 fp64 int32 int16 int8 bf16
+// arithmetic_type  = 0/1/2/3/4/5/6/7/8 = fp32 fp16 fp64 int32 int16 int8 bf16 fp8e4m3 fp8e5m2
+// packing_type     = 1/4/256       = scalar vec4/dotprod matrix, fp8 is matrix only with fp16 or else fp32 accumulation
+// return peak GFLOPS, or 0 if the combination is not supported on the gpu device
+double vkpeak(int loop, int count_mb, int cmd_loop, int storage_type, int arithmetic_type, int packing_type);
+
+// the vkpeak test with one generated kernel of unroll statements per loop over chains independent accumulators
+// unroll           = statements per loop, the default kernels use 16
+// chains           = 1 to unroll, matrix packing is not supported
+// return peak GFLOPS, or 0 if not supported
+double vkpeak_custom(int loop, int count_mb, int cmd_loop, int storage_type, int arithmetic_type, int packing_type, int unroll, int chains);
+
+// the vkpeak test with one generated kernel of chains independent accumulators instead of the built-in kernels
+// chains           = 1/2/4/8/16, 16 statements per loop over all chains, matrix packing is not supported
+// return peak GFLOPS, or 0 if not supported
+double vkpeak_ilp(int loop, int count_mb, int cmd_loop, int storage_type, int arithmetic_type, int packing_type, int chains);
+
+// run the vkpeak test of every storage_types[i] arithmetic_types[i] packing_types[i] back to back
+// the shaders of all tests are compiled on all cpu cores before the first one is timed
+// results[i] gets the GFLOPS of test i, 0 if not supported, and stats[i] its statistics if stats is not null
+// return 0 on success
+int vkpeak_sweep(int loop, int count_mb, int cmd_loop, int config_count, const int* storage_types, const int* arithmetic_types, const int* packing_types, double* results, vkpeak_stats* stats);
+
+// one subgroup scope cooperative matrix configuration advertised by the driver
+// a_type b_type c_type result_type are VkComponentTypeKHR values, the VkComponentTypeNV values are the same
+struct vkpeak_matrix_config
+{
+    int M;
+    int N;
+    int K;
+    int a_type;
+    int b_type;
+    int c_type;
+    int result_type;
+    int saturating;     // 1 if the multiply add must saturate on overflow of the accumulator
+};
+
+// number of advertised configurations, from VK_KHR_cooperative_matrix if present else VK_NV_cooperative_matrix
+int vkpeak_get_matrix_config_count();
+
+// return 0 on success
+int vkpeak_get_matrix_config(int config_index, vkpeak_matrix_config* config);
+
+// short name of a component type, for example fp16 bf16 s8 u8, ? if unknown
+const char* vkpeak_matrix_type_name(int component_type);
+
+// the vkpeak matrix test with a kernel generated for one advertised configuration
+// return peak GOPS, or 0 if the configuration is not supported
+double vkpeak_matrix(int loop, int count_mb, int cmd_loop, int config_index);
+
+// the vkpeak matrix test with rows a and cols b fragments per subgroup feeding a rows x cols grid of accumulators
+// rows cols        = 1 to 4, 1 1 is one accumulator chain
+// return peak GOPS, or 0 if not supported
+double vkpeak_matrix_blocked(int loop, int count_mb, int cmd_loop, int config_index, int rows, int cols);
+
+// gemm_type        = 0/1/2         = sgemm hgemm fp16 matrix
+// c = a * b with row major a M x K and b K x N uploaded from the host, M N K are padded to the tile sizes
+// sgemm and hgemm stage 64 x 64 tiles in shared memory, matrix loads cooperative matrices of the fp16 matrix peak shape
+// the k walk is repeated in the kernel until a submit is long enough
+// return GFLOPS of 2 * M * N * K per k walk, or 0 if not supported or the matrices exceed the work buffer budget
+double vkpeak_gemm(int cmd_loop, int gemm_type, int M, int N, int K);
+
+// storage_type     = 0/1           = fp32 fp16
+// access_type      = 0/1/2/3       = read write copy triad
+// packing_type     = 1/4           = scalar vec4
+// return streaming global memory bandwidth in GB/s, or 0 if not supported
+double vkpeak_bandwidth(int loop, int count_mb, int cmd_loop, int storage_type, int access_type, int packing_type);
+
+// access_type      = 0/1           = load store
+// stride           = element stride between neighbouring invocations, 1 for conflict free
+// return fp32 workgroup shared memory bandwidth in GB/s, or 0 if not supported
+double vkpeak_shared(int loop, int count_mb, int cmd_loop, int access_type, int stride);
+
+// arithmetic_type  = 0/1/3         = fp32 fp16 int32
+// op_type          = 0/1/2/3/4     = add shuffle shufflexor broadcast ballot
+// return subgroup op throughput in G lane-ops/s, or 0 if not supported
+double vkpeak_subgroup(int loop, int count_mb, int cmd_loop, int arithmetic_type, int op_type);
+
+// signedness_type  = 0/1/2         = signed unsigned mixed, mixed is signed a times unsigned b
+// saturating       = 0/1           = wrapping add saturating accumulate
+// packing_type     = 4/8           = int8 int4, int4 unpacks the nibbles of every word into two packed int8 dots
+//                                    and sign extends them when a is signed
+// return packed integer dot product throughput in GIOPS, or 0 if not supported
+double vkpeak_dot(int loop, int count_mb, int cmd_loop, int signedness_type, int saturating, int packing_type);
+
+// 1 if the driver reports the packed 4x8 dot product of signedness_type and saturating as accelerated
+int vkpeak_dot_accelerated(int signedness_type, int saturating);
+
+// arithmetic_type  = 0/1           = fp32 fp16
+// packing_type     = 1/4           = scalar vec4
+// func_type        = 0/1/2/3/4     = exp log sin rsqrt div
+// return special function throughput in Gops/s, or 0 if not supported
+double vkpeak_sfu(int loop, int count_mb, int cmd_loop, int arithmetic_type, int packing_type, int func_type);
+
+// footprint_kb     = size of the randomized pointer chase chain in KB
+// walker_type      = 0/1           = thread subgroup
+// return ns per dependent global memory load, or 0 if not supported
+double vkpeak_latency(int loop, int cmd_loop, int footprint_kb, int walker_type);
+
+// thread_count     = 1 = single core, 0 = all cpu cores
+// arithmetic_type  = 0/1/5         = fp32 fp16 int8
+// packing_type     = 4/256         = simd/dotprod matrix
+// return cpu peak GFLOPS, or 0 if the cpu or the build lacks the instruction set
+double vkpeak_cpu(int loop, int cmd_loop, int thread_count, int arithmetic_type, int packing_type);
+
+// instruction set of the kernel vkpeak_cpu picks, for example avx2 or asimddp, none if not supported
+const char* vkpeak_cpu_kernel_name(int arithmetic_type, int packing_type);
+
+// cpu clusters, the allowed cores with the same capacity and max frequency, the fastest cluster first
+// a single cluster of all allowed cores where the kernel exposes no cpu_capacity
+int vkpeak_cpu_cluster_count();
+int vkpeak_cpu_cluster_core_count(int cluster_index);
+// max frequency in MHz, 0 if unknown
+int vkpeak_cpu_cluster_max_freq(int cluster_index);
+
+// thread_count     = threads pinned one per core of the cluster, 0 = all cores of the cluster
+// return cpu peak GFLOPS of the cluster, or 0 if not supported or a thread could not be pinned
+double vkpeak_cpu_cluster(int loop, int cmd_loop, int cluster_index, int thread_count, int arithmetic_type, int packing_type);
+
+#endif // VKPEAK_H
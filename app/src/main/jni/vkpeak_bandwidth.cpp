@@ -0,0 +1,413 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "vkpeak.h"
+#include "vkpeak_runner.h"
+
+#include <algorithm>
+#include <vector>
+
+// ncnn
+#include <gpu.h>
+#include <mat.h>
+
+// the work buffer is split into three power-of-two regions a b c
+// every invocation walks its region with a grid stride and wraps around at the end,
+// so the footprint stays the whole region no matter how large loop grows
+
+static const char glsl_read_p1_data[] = R"(
+#version 450
+
+layout (constant_id = 0) const int loop = 1;
+layout (constant_id = 1) const int region = 1;
+
+layout (binding = 0) buffer c_blob { sfp c_blob_data[]; };
+
+void main()
+{
+    const uint gx = gl_GlobalInvocationID.x;
+    const uint stride = gl_NumWorkGroups.x * gl_WorkGroupSize.x;
+    const uint mask = uint(region) - 1;
+
+    afp c0 = afp(0.f);
+    afp c1 = afp(0.f);
+    afp c2 = afp(0.f);
+    afp c3 = afp(0.f);
+
+    uint i0 = gx;
+
+    for (int i = 0; i < loop; i++)
+    {
+        c0 += afp(c_blob_data[i0]);
+        c1 += afp(c_blob_data[(i0 + stride) & mask]);
+        c2 += afp(c_blob_data[(i0 + stride * 2) & mask]);
+        c3 += afp(c_blob_data[(i0 + stride * 3) & mask]);
+        i0 = (i0 + stride * 4) & mask;
+    }
+
+    c_blob_data[uint(region) * 2 + gx] = sfp((c0 + c1) + (c2 + c3));
+}
+)";
+
+static const char glsl_read_p4_data[] = R"(
+#version 450
+
+layout (constant_id = 0) const int loop = 1;
+layout (constant_id = 1) const int region = 1;
+
+layout (binding = 0) buffer c_blob { sfpvec4 c_blob_data[]; };
+
+void main()
+{
+    const uint gx = gl_GlobalInvocationID.x;
+    const uint stride = gl_NumWorkGroups.x * gl_WorkGroupSize.x;
+    const uint mask = uint(region) - 1;
+
+    afpvec4 c0 = afpvec4(0.f);
+    afpvec4 c1 = afpvec4(0.f);
+    afpvec4 c2 = afpvec4(0.f);
+    afpvec4 c3 = afpvec4(0.f);
+
+    uint i0 = gx;
+
+    for (int i = 0; i < loop; i++)
+    {
+        c0 += afpvec4(c_blob_data[i0]);
+        c1 += afpvec4(c_blob_data[(i0 + stride) & mask]);
+        c2 += afpvec4(c_blob_data[(i0 + stride * 2) & mask]);
+        c3 += afpvec4(c_blob_data[(i0 + stride * 3) & mask]);
+        i0 = (i0 + stride * 4) & mask;
+    }
+
+    c_blob_data[uint(region) * 2 + gx] = sfpvec4((c0 + c1) + (c2 + c3));
+}
+)";
+
+static const char glsl_write_p1_data[] = R"(
+#version 450
+
+layout (constant_id = 0) const int loop = 1;
+layout (constant_id = 1) const int region = 1;
+
+layout (binding = 0) writeonly buffer c_blob { sfp c_blob_data[]; };
+
+void main()
+{
+    const uint gx = gl_GlobalInvocationID.x;
+    const uint lx = gl_LocalInvocationID.x;
+    const uint stride = gl_NumWorkGroups.x * gl_WorkGroupSize.x;
+    const uint mask = uint(region) - 1;
+    const uint r2 = uint(region) * 2;
+
+    const sfp c = sfp(float(lx));
+
+    uint i0 = gx;
+
+    for (int i = 0; i < loop; i++)
+    {
+        c_blob_data[r2 + i0] = c;
+        c_blob_data[r2 + ((i0 + stride) & mask)] = c;
+        c_blob_data[r2 + ((i0 + stride * 2) & mask)] = c;
+        c_blob_data[r2 + ((i0 + stride * 3) & mask)] = c;
+        i0 = (i0 + stride * 4) & mask;
+    }
+}
+)";
+
+static const char glsl_write_p4_data[] = R"(
+#version 450
+
+layout (constant_id = 0) const int loop = 1;
+layout (constant_id = 1) const int region = 1;
+
+layout (binding = 0) writeonly buffer c_blob { sfpvec4 c_blob_data[]; };
+
+void main()
+{
+    const uint gx = gl_GlobalInvocationID.x;
+    const uint lx = gl_LocalInvocationID.x;
+    const uint stride = gl_NumWorkGroups.x * gl_WorkGroupSize.x;
+    const uint mask = uint(region) - 1;
+    const uint r2 = uint(region) * 2;
+
+    const sfpvec4 c = sfpvec4(afpvec4(lx) + afpvec4(0,1,2,3));
+
+    uint i0 = gx;
+
+    for (int i = 0; i < loop; i++)
+    {
+        c_blob_data[r2 + i0] = c;
+        c_blob_data[r2 + ((i0 + stride) & mask)] = c;
+        c_blob_data[r2 + ((i0 + stride * 2) & mask)] = c;
+        c_blob_data[r2 + ((i0 + stride * 3) & mask)] = c;
+        i0 = (i0 + stride * 4) & mask;
+    }
+}
+)";
+
+static const char glsl_copy_p1_data[] = R"(
+#version 450
+
+layout (constant_id = 0) const int loop = 1;
+layout (constant_id = 1) const int region = 1;
+
+layout (binding = 0) buffer c_blob { sfp c_blob_data[]; };
+
+void main()
+{
+    const uint gx = gl_GlobalInvocationID.x;
+    const uint stride = gl_NumWorkGroups.x * gl_WorkGroupSize.x;
+    const uint mask = uint(region) - 1;
+    const uint r2 = uint(region) * 2;
+
+    uint i0 = gx;
+
+    for (int i = 0; i < loop; i++)
+    {
+        const uint i1 = (i0 + stride) & mask;
+        const uint i2 = (i0 + stride * 2) & mask;
+        const uint i3 = (i0 + stride * 3) & mask;
+        c_blob_data[r2 + i0] = c_blob_data[i0];
+        c_blob_data[r2 + i1] = c_blob_data[i1];
+        c_blob_data[r2 + i2] = c_blob_data[i2];
+        c_blob_data[r2 + i3] = c_blob_data[i3];
+        i0 = (i0 + stride * 4) & mask;
+    }
+}
+)";
+
+static const char glsl_copy_p4_data[] = R"(
+#version 450
+
+layout (constant_id = 0) const int loop = 1;
+layout (constant_id = 1) const int region = 1;
+
+layout (binding = 0) buffer c_blob { sfpvec4 c_blob_data[]; };
+
+void main()
+{
+    const uint gx = gl_GlobalInvocationID.x;
+    const uint stride = gl_NumWorkGroups.x * gl_WorkGroupSize.x;
+    const uint mask = uint(region) - 1;
+    const uint r2 = uint(region) * 2;
+
+    uint i0 = gx;
+
+    for (int i = 0; i < loop; i++)
+    {
+        const uint i1 = (i0 + stride) & mask;
+        const uint i2 = (i0 + stride * 2) & mask;
+        const uint i3 = (i0 + stride * 3) & mask;
+        c_blob_data[r2 + i0] = c_blob_data[i0];
+        c_blob_data[r2 + i1] = c_blob_data[i1];
+        c_blob_data[r2 + i2] = c_blob_data[i2];
+        c_blob_data[r2 + i3] = c_blob_data[i3];
+        i0 = (i0 + stride * 4) & mask;
+    }
+}
+)";
+
+static const char glsl_triad_p1_data[] = R"(
+#version 450
+
+layout (constant_id = 0) const int loop = 1;
+layout (constant_id = 1) const int region = 1;
+
+layout (binding = 0) buffer c_blob { sfp c_blob_data[]; };
+
+void main()
+{
+    const uint gx = gl_GlobalInvocationID.x;
+    const uint lx = gl_LocalInvocationID.x;
+    const uint stride = gl_NumWorkGroups.x * gl_WorkGroupSize.x;
+    const uint mask = uint(region) - 1;
+    const uint r1 = uint(region);
+    const uint r2 = uint(region) * 2;
+
+    const afp s = afp(lx);
+
+    uint i0 = gx;
+
+    for (int i = 0; i < loop; i++)
+    {
+        const uint i1 = (i0 + stride) & mask;
+        const uint i2 = (i0 + stride * 2) & mask;
+        const uint i3 = (i0 + stride * 3) & mask;
+        c_blob_data[r2 + i0] = sfp(afp(c_blob_data[i0]) + s * afp(c_blob_data[r1 + i0]));
+        c_blob_data[r2 + i1] = sfp(afp(c_blob_data[i1]) + s * afp(c_blob_data[r1 + i1]));
+        c_blob_data[r2 + i2] = sfp(afp(c_blob_data[i2]) + s * afp(c_blob_data[r1 + i2]));
+        c_blob_data[r2 + i3] = sfp(afp(c_blob_data[i3]) + s * afp(c_blob_data[r1 + i3]));
+        i0 = (i0 + stride * 4) & mask;
+    }
+}
+)";
+
+static const char glsl_triad_p4_data[] = R"(
+#version 450
+
+layout (constant_id = 0) const int loop = 1;
+layout (constant_id = 1) const int region = 1;
+
+layout (binding = 0) buffer c_blob { sfpvec4 c_blob_data[]; };
+
+void main()
+{
+    const uint gx = gl_GlobalInvocationID.x;
+    const uint lx = gl_LocalInvocationID.x;
+    const uint stride = gl_NumWorkGroups.x * gl_WorkGroupSize.x;
+    const uint mask = uint(region) - 1;
+    const uint r1 = uint(region);
+    const uint r2 = uint(region) * 2;
+
+    const afp s = afp(lx);
+
+    uint i0 = gx;
+
+    for (int i = 0; i < loop; i++)
+    {
+        const uint i1 = (i0 + stride) & mask;
+        const uint i2 = (i0 + stride * 2) & mask;
+        const uint i3 = (i0 + stride * 3) & mask;
+        c_blob_data[r2 + i0] = sfpvec4(afpvec4(c_blob_data[i0]) + s * afpvec4(c_blob_data[r1 + i0]));
+        c_blob_data[r2 + i1] = sfpvec4(afpvec4(c_blob_data[i1]) + s * afpvec4(c_blob_data[r1 + i1]));
+        c_blob_data[r2 + i2] = sfpvec4(afpvec4(c_blob_data[i2]) + s * afpvec4(c_blob_data[r1 + i2]));
+        c_blob_data[r2 + i3] = sfpvec4(afpvec4(c_blob_data[i3]) + s * afpvec4(c_blob_data[r1 + i3]));
+        i0 = (i0 + stride * 4) & mask;
+    }
+}
+)";
+
+double vkpeak_bandwidth(int loop, int count_mb, int cmd_loop, int storage_type, int access_type, int packing_type)
+{
+    ncnn::VulkanDevice* vkdev = vkpeak_get_device();
+
+    if (!vkdev)
+    {
+        return 0;
+    }
+
+    if (!vkdev->info.support_fp16_storage() && storage_type == 1)
+    {
+        return 0;
+    }
+    if (storage_type != 0 && storage_type != 1)
+    {
+        return 0;
+    }
+    if (packing_type != 1 && packing_type != 4)
+    {
+        return 0;
+    }
+
+    ncnn::Option opt;
+    opt.use_vulkan_compute = true;
+    opt.use_fp16_packed = storage_type == 1;
+    opt.use_fp16_storage = storage_type == 1;
+    opt.use_fp16_arithmetic = false;
+
+    vkpeak_kernel kernel;
+
+    // -1 for omit the tail '\0'
+    if (access_type == 0)
+    {
+        if (packing_type == 1)
+            kernel.glsl.assign(glsl_read_p1_data, sizeof(glsl_read_p1_data) - 1);
+        if (packing_type == 4)
+            kernel.glsl.assign(glsl_read_p4_data, sizeof(glsl_read_p4_data) - 1);
+    }
+    else if (access_type == 1)
+    {
+        if (packing_type == 1)
+            kernel.glsl.assign(glsl_write_p1_data, sizeof(glsl_write_p1_data) - 1);
+        if (packing_type == 4)
+            kernel.glsl.assign(glsl_write_p4_data, sizeof(glsl_write_p4_data) - 1);
+    }
+    else if (access_type == 2)
+    {
+        if (packing_type == 1)
+            kernel.glsl.assign(glsl_copy_p1_data, sizeof(glsl_copy_p1_data) - 1);
+        if (packing_type == 4)
+            kernel.glsl.assign(glsl_copy_p4_data, sizeof(glsl_copy_p4_data) - 1);
+    }
+    else if (access_type == 3)
+    {
+        if (packing_type == 1)
+            kernel.glsl.assign(glsl_triad_p1_data, sizeof(glsl_triad_p1_data) - 1);
+        if (packing_type == 4)
+            kernel.glsl.assign(glsl_triad_p4_data, sizeof(glsl_triad_p4_data) - 1);
+    }
+
+    if (kernel.glsl.empty())
+    {
+        return 0;
+    }
+
+    const int elemsize = (storage_type == 1 ? 2 : 4) * packing_type;
+
+    // 4 elements per loop, read write copy triad touch 1 1 2 3 of them each
+    const int access_count[4] = {1, 1, 2, 3};
+    kernel.ops_per_loop = 4.0 * access_count[access_type] * elemsize;
+    kernel.ops_tail = access_type == 0 ? elemsize : 0; // read stores its sum
+
+    int local_size_x = vkpeak_local_size(vkdev, std::min(128, std::max(1, (int)vkdev->info.subgroup_size())));
+
+    ncnn::VkAllocator* allocator = vkdev->acquire_blob_allocator();
+
+    int buffer_size = vkpeak_buffer_size(vkdev, count_mb);
+
+    // three power-of-two regions, each must hold at least eight workgroups
+    int region = 1;
+    while (region * 2 <= buffer_size / elemsize / 3)
+    {
+        region *= 2;
+    }
+    if (region / 8 < local_size_x)
+    {
+        vkdev->reclaim_blob_allocator(allocator);
+        return 0;
+    }
+
+    // the grid stride is invocation_count, keep stride * 4 below region so that i0 keeps
+    // walking the region instead of folding back onto the same four elements every loop
+    int invocation_count = std::min(region / 8, 65535 * local_size_x);
+    invocation_count = std::max(invocation_count / local_size_x, 1) * local_size_x;
+
+    if ((invocation_count * 4) % region == 0)
+    {
+        vkdev->reclaim_blob_allocator(allocator);
+        return 0;
+    }
+
+    ncnn::VkMat c(buffer_size, (size_t)1u, 1, allocator);
+
+    std::vector<ncnn::vk_specialization_type> specializations(2);
+    specializations[1].i = region;
+
+    vkpeak_workload workload;
+    workload.vkdev = vkdev;
+    workload.opt = opt;
+    workload.kernels.push_back(kernel);
+    workload.specializations = specializations;
+    workload.bindings.push_back(c);
+    workload.local_size_x = local_size_x;
+    workload.invocation_count = invocation_count;
+    workload.max_invocation_count = invocation_count;
+    workload.split_queues = false;
+
+    double max_gbps = vkpeak_run(workload, loop, cmd_loop);
+
+    vkdev->reclaim_blob_allocator(allocator);
+
+    return max_gbps;
+}
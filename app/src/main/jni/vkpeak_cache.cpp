@@ -0,0 +1,205 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "vkpeak.h"
+#include "vkpeak_cache.h"
+
+#include <stdio.h>
+#include <string.h>
+
+#if defined _WIN32
+#include <process.h>
+#else
+#include <unistd.h>
+#endif
+
+#include <map>
+
+// ncnn
+#include <gpu.h>
+#include <platform.h>
+
+static ncnn::Mutex g_cache_lock;
+static std::string g_cache_dir;
+static std::map<uint64_t, std::vector<uint32_t> > g_spirv_cache;
+static unsigned int g_cache_tmp_serial = 0;
+
+void vkpeak_set_cache_dir(const char* cache_dir)
+{
+    ncnn::MutexLockGuard g(g_cache_lock);
+
+    g_cache_dir = cache_dir ? cache_dir : "";
+}
+
+// fnv-1a 64bit
+static void hash_bytes(uint64_t& h, const void* data, size_t size)
+{
+    const unsigned char* p = (const unsigned char*)data;
+    for (size_t i = 0; i < size; i++)
+    {
+        h ^= p[i];
+        h *= 0x100000001b3ull;
+    }
+}
+
+static uint64_t spirv_cache_key(const ncnn::VulkanDevice* vkdev, const std::string& glsl, const ncnn::Option& opt)
+{
+    uint64_t h = 0xcbf29ce484222325ull;
+
+    hash_bytes(h, glsl.data(), glsl.size());
+
+    // the flags compile_spirv_module turns into sfp afp and friends
+    const unsigned char flags[] = {
+        opt.use_fp16_packed,
+        opt.use_fp16_storage,
+        opt.use_fp16_arithmetic,
+        opt.use_int8_storage,
+        opt.use_int8_arithmetic,
+        opt.use_bf16_storage,
+        opt.use_shader_local_memory,
+        opt.use_subgroup_ops,
+        opt.use_cooperative_matrix,
+    };
+    hash_bytes(h, flags, sizeof(flags));
+
+    // a newer glslang in ncnn may emit different spirv
+    hash_bytes(h, NCNN_VERSION_STRING, strlen(NCNN_VERSION_STRING));
+
+    const ncnn::GpuInfo& info = vkdev->info;
+    hash_bytes(h, info.pipeline_cache_uuid(), VK_UUID_SIZE);
+
+    const uint32_t ids[3] = {info.vendor_id(), info.device_id(), info.driver_version()};
+    hash_bytes(h, ids, sizeof(ids));
+
+    return h;
+}
+
+static bool load_spirv(const std::string& path, std::vector<uint32_t>& spirv)
+{
+    FILE* fp = fopen(path.c_str(), "rb");
+    if (!fp)
+        return false;
+
+    fseek(fp, 0, SEEK_END);
+    long size = ftell(fp);
+    fseek(fp, 0, SEEK_SET);
+
+    // reject truncated files and anything without the spirv magic
+    if (size < 20 || size % 4 != 0)
+    {
+        fclose(fp);
+        return false;
+    }
+
+    spirv.resize(size / 4);
+    size_t nread = fread(spirv.data(), 4, spirv.size(), fp);
+    fclose(fp);
+
+    if (nread != spirv.size() || spirv[0] != 0x07230203)
+    {
+        spirv.clear();
+        return false;
+    }
+
+    return true;
+}
+
+static void save_spirv(const std::string& path, const std::vector<uint32_t>& spirv)
+{
+    // write aside and rename, a concurrent reader never sees a partial file
+    // the temp name is unique per process and per call, so parallel writers never share it
+    unsigned int serial;
+    {
+        ncnn::MutexLockGuard g(g_cache_lock);
+
+        serial = g_cache_tmp_serial++;
+    }
+
+#if defined _WIN32
+    const int pid = _getpid();
+#else
+    const int pid = (int)getpid();
+#endif
+
+    char suffix[32];
+    sprintf(suffix, ".%d.%u.tmp", pid, serial);
+    const std::string tmppath = path + suffix;
+
+    FILE* fp = fopen(tmppath.c_str(), "wb");
+    if (!fp)
+        return;
+
+    size_t nwrite = fwrite(spirv.data(), 4, spirv.size(), fp);
+    int ret = fclose(fp);
+
+    if (nwrite != spirv.size() || ret != 0)
+    {
+        remove(tmppath.c_str());
+        return;
+    }
+
+    // another writer may have published the same blob first, keep theirs
+    if (rename(tmppath.c_str(), path.c_str()) != 0)
+    {
+        remove(tmppath.c_str());
+    }
+}
+
+int vkpeak_compile_spirv(const ncnn::VulkanDevice* vkdev, const std::string& glsl, const ncnn::Option& opt, std::vector<uint32_t>& spirv)
+{
+    const uint64_t key = spirv_cache_key(vkdev, glsl, opt);
+
+    std::string path;
+    {
+        ncnn::MutexLockGuard g(g_cache_lock);
+
+        std::map<uint64_t, std::vector<uint32_t> >::const_iterator it = g_spirv_cache.find(key);
+        if (it != g_spirv_cache.end())
+        {
+            spirv = it->second;
+            return 0;
+        }
+
+        if (!g_cache_dir.empty())
+        {
+            char name[32];
+            sprintf(name, "/%016llx.spv", (unsigned long long)key);
+            path = g_cache_dir + name;
+        }
+    }
+
+    if (path.empty() || !load_spirv(path, spirv))
+    {
+        spirv.clear();
+
+        int ret = ncnn::compile_spirv_module(glsl.data(), (int)glsl.size(), opt, spirv);
+        if (ret != 0 || spirv.empty())
+        {
+            return -1;
+        }
+
+        if (!path.empty())
+        {
+            save_spirv(path, spirv);
+        }
+    }
+
+    {
+        ncnn::MutexLockGuard g(g_cache_lock);
+
+        g_spirv_cache[key] = spirv;
+    }
+
+    return 0;
+}
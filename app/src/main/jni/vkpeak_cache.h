@@ -0,0 +1,32 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef VKPEAK_CACHE_H
+#define VKPEAK_CACHE_H
+
+#include <string>
+#include <vector>
+
+// ncnn
+#include <gpu.h>
+#include <option.h>
+
+// glsl to spirv through a content addressed cache
+// the key covers the glsl source, the option flags that drive the ncnn glsl macros,
+// the ncnn version, the device pipeline cache uuid and the driver version
+// hits come from memory first, then from the cache directory if one is set
+// return 0 on success
+int vkpeak_compile_spirv(const ncnn::VulkanDevice* vkdev, const std::string& glsl, const ncnn::Option& opt, std::vector<uint32_t>& spirv);
+
+#endif // VKPEAK_CACHE_H
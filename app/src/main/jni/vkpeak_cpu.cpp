@@ -0,0 +1,670 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "vkpeak.h"
+#include "vkpeak_cpu.h"
+
+#include <stdio.h>
+
+#if defined(__linux__) || defined(__ANDROID__)
+#include <sched.h>
+#endif
+
+#include <algorithm>
+#include <vector>
+
+#if defined(__SSE2__)
+#include <emmintrin.h>
+#endif
+#if defined(__ARM_NEON)
+#include <arm_neon.h>
+#endif
+
+// ncnn
+#include <benchmark.h>
+#include <cpu.h>
+#include <platform.h>
+
+#if defined(__SSE2__)
+// 8 chains of 4 lanes, sse has no fma so every step is a dependent mul and add
+float vkpeak_cpu_fp32_sse2(int loop)
+{
+    __m128 c0 = _mm_set1_ps(0.0f);
+    __m128 c1 = _mm_set1_ps(0.1f);
+    __m128 c2 = _mm_set1_ps(0.2f);
+    __m128 c3 = _mm_set1_ps(0.3f);
+    __m128 c4 = _mm_set1_ps(0.4f);
+    __m128 c5 = _mm_set1_ps(0.5f);
+    __m128 c6 = _mm_set1_ps(0.6f);
+    __m128 c7 = _mm_set1_ps(0.7f);
+
+    const __m128 a = _mm_set1_ps(0.5f);
+    const __m128 b = _mm_set1_ps(0.25f);
+
+    for (int i = 0; i < loop; i++)
+    {
+        c0 = _mm_add_ps(_mm_mul_ps(c0, a), b);
+        c1 = _mm_add_ps(_mm_mul_ps(c1, a), b);
+        c2 = _mm_add_ps(_mm_mul_ps(c2, a), b);
+        c3 = _mm_add_ps(_mm_mul_ps(c3, a), b);
+        c4 = _mm_add_ps(_mm_mul_ps(c4, a), b);
+        c5 = _mm_add_ps(_mm_mul_ps(c5, a), b);
+        c6 = _mm_add_ps(_mm_mul_ps(c6, a), b);
+        c7 = _mm_add_ps(_mm_mul_ps(c7, a), b);
+    }
+
+    c0 = _mm_add_ps(c0, c1);
+    c2 = _mm_add_ps(c2, c3);
+    c4 = _mm_add_ps(c4, c5);
+    c6 = _mm_add_ps(c6, c7);
+    c0 = _mm_add_ps(c0, c2);
+    c4 = _mm_add_ps(c4, c6);
+    c0 = _mm_add_ps(c0, c4);
+
+    float tmp[4];
+    _mm_storeu_ps(tmp, c0);
+
+    return tmp[0] + tmp[1] + tmp[2] + tmp[3];
+}
+#endif // __SSE2__
+
+#if defined(__ARM_NEON)
+#if __aarch64__
+// 24 chains of 4 lanes out of 32 q registers
+float vkpeak_cpu_fp32_neon(int loop)
+{
+    float32x4_t c0 = vdupq_n_f32(0.0f);
+    float32x4_t c1 = vdupq_n_f32(0.1f);
+    float32x4_t c2 = vdupq_n_f32(0.2f);
+    float32x4_t c3 = vdupq_n_f32(0.3f);
+    float32x4_t c4 = vdupq_n_f32(0.4f);
+    float32x4_t c5 = vdupq_n_f32(0.5f);
+    float32x4_t c6 = vdupq_n_f32(0.6f);
+    float32x4_t c7 = vdupq_n_f32(0.7f);
+    float32x4_t c8 = vdupq_n_f32(0.8f);
+    float32x4_t c9 = vdupq_n_f32(0.9f);
+    float32x4_t ca = vdupq_n_f32(1.0f);
+    float32x4_t cb = vdupq_n_f32(1.1f);
+    float32x4_t cc = vdupq_n_f32(1.2f);
+    float32x4_t cd = vdupq_n_f32(1.3f);
+    float32x4_t ce = vdupq_n_f32(1.4f);
+    float32x4_t cf = vdupq_n_f32(1.5f);
+    float32x4_t cg = vdupq_n_f32(1.6f);
+    float32x4_t ch = vdupq_n_f32(1.7f);
+    float32x4_t ci = vdupq_n_f32(1.8f);
+    float32x4_t cj = vdupq_n_f32(1.9f);
+    float32x4_t ck = vdupq_n_f32(2.0f);
+    float32x4_t cl = vdupq_n_f32(2.1f);
+    float32x4_t cm = vdupq_n_f32(2.2f);
+    float32x4_t cn = vdupq_n_f32(2.3f);
+
+    const float32x4_t a = vdupq_n_f32(0.5f);
+    const float32x4_t b = vdupq_n_f32(0.25f);
+
+    for (int i = 0; i < loop; i++)
+    {
+        c0 = vfmaq_f32(b, c0, a);
+        c1 = vfmaq_f32(b, c1, a);
+        c2 = vfmaq_f32(b, c2, a);
+        c3 = vfmaq_f32(b, c3, a);
+        c4 = vfmaq_f32(b, c4, a);
+        c5 = vfmaq_f32(b, c5, a);
+        c6 = vfmaq_f32(b, c6, a);
+        c7 = vfmaq_f32(b, c7, a);
+        c8 = vfmaq_f32(b, c8, a);
+        c9 = vfmaq_f32(b, c9, a);
+        ca = vfmaq_f32(b, ca, a);
+        cb = vfmaq_f32(b, cb, a);
+        cc = vfmaq_f32(b, cc, a);
+        cd = vfmaq_f32(b, cd, a);
+        ce = vfmaq_f32(b, ce, a);
+        cf = vfmaq_f32(b, cf, a);
+        cg = vfmaq_f32(b, cg, a);
+        ch = vfmaq_f32(b, ch, a);
+        ci = vfmaq_f32(b, ci, a);
+        cj = vfmaq_f32(b, cj, a);
+        ck = vfmaq_f32(b, ck, a);
+        cl = vfmaq_f32(b, cl, a);
+        cm = vfmaq_f32(b, cm, a);
+        cn = vfmaq_f32(b, cn, a);
+    }
+
+    c0 = vaddq_f32(c0, c1);
+    c2 = vaddq_f32(c2, c3);
+    c4 = vaddq_f32(c4, c5);
+    c6 = vaddq_f32(c6, c7);
+    c8 = vaddq_f32(c8, c9);
+    ca = vaddq_f32(ca, cb);
+    cc = vaddq_f32(cc, cd);
+    ce = vaddq_f32(ce, cf);
+    cg = vaddq_f32(cg, ch);
+    ci = vaddq_f32(ci, cj);
+    ck = vaddq_f32(ck, cl);
+    cm = vaddq_f32(cm, cn);
+    c0 = vaddq_f32(c0, c2);
+    c4 = vaddq_f32(c4, c6);
+    c8 = vaddq_f32(c8, ca);
+    cc = vaddq_f32(cc, ce);
+    cg = vaddq_f32(cg, ci);
+    ck = vaddq_f32(ck, cm);
+    c0 = vaddq_f32(c0, c4);
+    c8 = vaddq_f32(c8, cc);
+    cg = vaddq_f32(cg, ck);
+    c0 = vaddq_f32(c0, c8);
+    c0 = vaddq_f32(c0, cg);
+
+    return vaddvq_f32(c0);
+}
+#else  // __aarch64__
+// 12 chains of 4 lanes out of 16 q registers
+float vkpeak_cpu_fp32_neon(int loop)
+{
+    float32x4_t c0 = vdupq_n_f32(0.0f);
+    float32x4_t c1 = vdupq_n_f32(0.1f);
+    float32x4_t c2 = vdupq_n_f32(0.2f);
+    float32x4_t c3 = vdupq_n_f32(0.3f);
+    float32x4_t c4 = vdupq_n_f32(0.4f);
+    float32x4_t c5 = vdupq_n_f32(0.5f);
+    float32x4_t c6 = vdupq_n_f32(0.6f);
+    float32x4_t c7 = vdupq_n_f32(0.7f);
+    float32x4_t c8 = vdupq_n_f32(0.8f);
+    float32x4_t c9 = vdupq_n_f32(0.9f);
+    float32x4_t ca = vdupq_n_f32(1.0f);
+    float32x4_t cb = vdupq_n_f32(1.1f);
+
+    const float32x4_t a = vdupq_n_f32(0.5f);
+    const float32x4_t b = vdupq_n_f32(0.25f);
+
+    for (int i = 0; i < loop; i++)
+    {
+        c0 = vmlaq_f32(b, c0, a);
+        c1 = vmlaq_f32(b, c1, a);
+        c2 = vmlaq_f32(b, c2, a);
+        c3 = vmlaq_f32(b, c3, a);
+        c4 = vmlaq_f32(b, c4, a);
+        c5 = vmlaq_f32(b, c5, a);
+        c6 = vmlaq_f32(b, c6, a);
+        c7 = vmlaq_f32(b, c7, a);
+        c8 = vmlaq_f32(b, c8, a);
+        c9 = vmlaq_f32(b, c9, a);
+        ca = vmlaq_f32(b, ca, a);
+        cb = vmlaq_f32(b, cb, a);
+    }
+
+    c0 = vaddq_f32(c0, c1);
+    c2 = vaddq_f32(c2, c3);
+    c4 = vaddq_f32(c4, c5);
+    c6 = vaddq_f32(c6, c7);
+    c8 = vaddq_f32(c8, c9);
+    ca = vaddq_f32(ca, cb);
+    c0 = vaddq_f32(c0, c2);
+    c4 = vaddq_f32(c4, c6);
+    c8 = vaddq_f32(c8, ca);
+    c0 = vaddq_f32(c0, c4);
+    c0 = vaddq_f32(c0, c8);
+
+    float tmp[4];
+    vst1q_f32(tmp, c0);
+
+    return tmp[0] + tmp[1] + tmp[2] + tmp[3];
+}
+#endif // __aarch64__
+#endif // __ARM_NEON
+
+struct vkpeak_cpu_kernel
+{
+    const char* name;
+
+    float (*func)(int loop);
+
+    // multiply-add counts as 2 ops
+    double ops_per_loop;
+};
+
+// the widest kernel this binary has and this cpu can run
+// VKPEAK_CPU_* tell which instruction set translation units were built by the compiler
+static bool select_kernel(int arithmetic_type, int packing_type, vkpeak_cpu_kernel& kernel)
+{
+    kernel.name = 0;
+    kernel.func = 0;
+    kernel.ops_per_loop = 0;
+
+    if (arithmetic_type == 0 && packing_type == 4)
+    {
+#if VKPEAK_CPU_AVX512
+        if (ncnn::cpu_support_x86_avx512())
+        {
+            kernel.name = "avx512";
+            kernel.func = vkpeak_cpu_fp32_avx512;
+            kernel.ops_per_loop = 24 * 16 * 2;
+            return true;
+        }
+#endif
+#if VKPEAK_CPU_AVX2
+        if (ncnn::cpu_support_x86_avx2() && ncnn::cpu_support_x86_fma())
+        {
+            kernel.name = "avx2";
+            kernel.func = vkpeak_cpu_fp32_avx2;
+            kernel.ops_per_loop = 12 * 8 * 2;
+            return true;
+        }
+#endif
+#if defined(__SSE2__)
+        kernel.name = "sse2";
+        kernel.func = vkpeak_cpu_fp32_sse2;
+        kernel.ops_per_loop = 8 * 4 * 2;
+        return true;
+#endif
+#if defined(__ARM_NEON)
+        kernel.name = "neon";
+        kernel.func = vkpeak_cpu_fp32_neon;
+#if __aarch64__
+        kernel.ops_per_loop = 24 * 4 * 2;
+#else
+        kernel.ops_per_loop = 12 * 4 * 2;
+#endif
+        return true;
+#endif
+    }
+
+    if (arithmetic_type == 1 && packing_type == 4)
+    {
+#if VKPEAK_CPU_ASIMDHP
+        if (ncnn::cpu_support_arm_asimdhp())
+        {
+            kernel.name = "asimdhp";
+            kernel.func = vkpeak_cpu_fp16_asimdhp;
+            kernel.ops_per_loop = 24 * 8 * 2;
+            return true;
+        }
+#endif
+    }
+
+    if (arithmetic_type == 5 && packing_type == 4)
+    {
+#if VKPEAK_CPU_AVX512VNNI
+        if (ncnn::cpu_support_x86_avx512_vnni())
+        {
+            kernel.name = "avx512vnni";
+            kernel.func = vkpeak_cpu_int8_avx512vnni;
+            kernel.ops_per_loop = 24 * 64 * 2;
+            return true;
+        }
+#endif
+#if VKPEAK_CPU_AVXVNNI
+        if (ncnn::cpu_support_x86_avx_vnni())
+        {
+            kernel.name = "avxvnni";
+            kernel.func = vkpeak_cpu_int8_avxvnni;
+            kernel.ops_per_loop = 12 * 32 * 2;
+            return true;
+        }
+#endif
+#if VKPEAK_CPU_ASIMDDP
+        if (ncnn::cpu_support_arm_asimddp())
+        {
+            kernel.name = "asimddp";
+            kernel.func = vkpeak_cpu_int8_asimddp;
+            kernel.ops_per_loop = 24 * 16 * 2;
+            return true;
+        }
+#endif
+    }
+
+    if (arithmetic_type == 5 && packing_type == 256)
+    {
+#if VKPEAK_CPU_I8MM
+        if (ncnn::cpu_support_arm_i8mm())
+        {
+            kernel.name = "i8mm";
+            kernel.func = vkpeak_cpu_int8_i8mm;
+            kernel.ops_per_loop = 24 * 32 * 2;
+            return true;
+        }
+#endif
+    }
+
+    return false;
+}
+
+const char* vkpeak_cpu_kernel_name(int arithmetic_type, int packing_type)
+{
+    vkpeak_cpu_kernel kernel;
+    if (!select_kernel(arithmetic_type, packing_type, kernel))
+        return "none";
+
+    return kernel.name;
+}
+
+struct vkpeak_cpu_task
+{
+    const vkpeak_cpu_kernel* kernel;
+    int loop;
+
+    // pin to this cpu, -1 for no affinity
+    int cpu;
+
+    // false if the pinning was refused
+    bool pinned;
+
+    float result;
+};
+
+static bool set_thread_affinity(int cpu)
+{
+#if defined(__linux__) || defined(__ANDROID__)
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    CPU_SET(cpu, &mask);
+
+    // pid 0 is the calling thread
+    return sched_setaffinity(0, sizeof(mask), &mask) == 0;
+#else
+    (void)cpu;
+    return true;
+#endif
+}
+
+static void* cpu_worker(void* args)
+{
+    vkpeak_cpu_task* task = (vkpeak_cpu_task*)args;
+
+    if (task->cpu != -1)
+    {
+        task->pinned = set_thread_affinity(task->cpu);
+    }
+
+    task->result = task->kernel->func(task->loop);
+
+    return 0;
+}
+
+// cpus lists the core of every thread, -1 for no affinity
+static double run_kernel(const vkpeak_cpu_kernel& kernel, int loop, int cmd_loop, const std::vector<int>& cpus)
+{
+    const int thread_count = (int)cpus.size();
+
+    double max_gops = 0;
+
+    std::vector<vkpeak_cpu_task> tasks(thread_count);
+
+    int i = 0;
+    while (i < cmd_loop)
+    {
+        for (int t = 0; t < thread_count; t++)
+        {
+            tasks[t].kernel = &kernel;
+            tasks[t].loop = loop;
+            tasks[t].cpu = cpus[t];
+            tasks[t].pinned = true;
+            tasks[t].result = 0.f;
+        }
+
+        double t0 = ncnn::get_current_time();
+
+        if (thread_count == 1 && cpus[0] == -1)
+        {
+            cpu_worker(&tasks[0]);
+        }
+        else
+        {
+            // pinned workers never change the affinity of the calling thread
+            std::vector<ncnn::Thread*> threads(thread_count);
+            for (int t = 0; t < thread_count; t++)
+            {
+                threads[t] = new ncnn::Thread(cpu_worker, &tasks[t]);
+            }
+            for (int t = 0; t < thread_count; t++)
+            {
+                threads[t]->join();
+                delete threads[t];
+            }
+        }
+
+        double t1 = ncnn::get_current_time();
+
+        // an unpinned thread would report against the wrong core
+        for (int t = 0; t < thread_count; t++)
+        {
+            if (!tasks[t].pinned)
+                return 0;
+        }
+
+        const double time = t1 - t0;
+
+        // thread startup and the first frequency ramp vanish in 200ms
+        if (time < 200)
+        {
+            loop *= 2;
+            i = 0;
+            continue;
+        }
+
+        double ops = (double)thread_count * loop * kernel.ops_per_loop;
+
+        double gops = ops / time / 1000000;
+
+        if (gops > max_gops)
+            max_gops = gops;
+
+        i++;
+    }
+
+    return max_gops;
+}
+
+double vkpeak_cpu(int loop, int cmd_loop, int thread_count, int arithmetic_type, int packing_type)
+{
+    vkpeak_cpu_kernel kernel;
+    if (!select_kernel(arithmetic_type, packing_type, kernel))
+    {
+        return 0;
+    }
+
+    if (thread_count <= 0)
+    {
+        thread_count = ncnn::get_cpu_count();
+    }
+
+    std::vector<int> cpus(thread_count, -1);
+
+    return run_kernel(kernel, loop, cmd_loop, cpus);
+}
+
+struct vkpeak_cpu_cluster_info
+{
+    int capacity;
+    int max_freq_khz;
+
+    std::vector<int> cpus;
+};
+
+static int read_sysfs_int(const char* path)
+{
+    FILE* fp = fopen(path, "rb");
+    if (!fp)
+        return -1;
+
+    int value = -1;
+    int nscan = fscanf(fp, "%d", &value);
+    fclose(fp);
+
+    return nscan == 1 ? value : -1;
+}
+
+static bool cluster_faster(const vkpeak_cpu_cluster_info& a, const vkpeak_cpu_cluster_info& b)
+{
+    if (a.capacity != b.capacity)
+        return a.capacity > b.capacity;
+
+    return a.max_freq_khz > b.max_freq_khz;
+}
+
+// the cpus this process may run on, in cpuset or container limits and without offline cpus
+static std::vector<int> get_allowed_cpus()
+{
+    std::vector<int> cpus;
+
+#if defined(__linux__) || defined(__ANDROID__)
+    cpu_set_t mask;
+    CPU_ZERO(&mask);
+    if (sched_getaffinity(0, sizeof(mask), &mask) == 0)
+    {
+        for (int i = 0; i < CPU_SETSIZE; i++)
+        {
+            if (CPU_ISSET(i, &mask))
+                cpus.push_back(i);
+        }
+
+        return cpus;
+    }
+#endif
+
+    const int cpu_count = ncnn::get_cpu_count();
+    for (int i = 0; i < cpu_count; i++)
+    {
+        cpus.push_back(i);
+    }
+
+    return cpus;
+}
+
+// cores with the same capacity and max frequency form one cluster, the fastest cluster first
+// only cpu_capacity tells big and little cores apart, the max frequency of x86 preferred cores
+// differs per core, so without cpu_capacity every core lands in one cluster
+static const std::vector<vkpeak_cpu_cluster_info>& get_clusters()
+{
+    static std::vector<vkpeak_cpu_cluster_info> clusters;
+    static bool initialized = false;
+
+    if (initialized)
+        return clusters;
+
+    const std::vector<int> cpus = get_allowed_cpus();
+
+    std::vector<int> capacities(cpus.size());
+    std::vector<int> max_freqs_khz(cpus.size());
+
+    bool has_capacity = !cpus.empty();
+    for (size_t i = 0; i < cpus.size(); i++)
+    {
+        char path[256];
+
+        sprintf(path, "/sys/devices/system/cpu/cpu%d/cpu_capacity", cpus[i]);
+        capacities[i] = read_sysfs_int(path);
+
+        sprintf(path, "/sys/devices/system/cpu/cpu%d/cpufreq/cpuinfo_max_freq", cpus[i]);
+        max_freqs_khz[i] = read_sysfs_int(path);
+
+        if (capacities[i] == -1)
+            has_capacity = false;
+    }
+
+    if (!has_capacity)
+    {
+        if (!cpus.empty())
+        {
+            vkpeak_cpu_cluster_info cluster;
+            cluster.capacity = -1;
+            cluster.max_freq_khz = *std::max_element(max_freqs_khz.begin(), max_freqs_khz.end());
+            cluster.cpus = cpus;
+            clusters.push_back(cluster);
+        }
+
+        initialized = true;
+
+        return clusters;
+    }
+
+    for (size_t i = 0; i < cpus.size(); i++)
+    {
+        size_t j = 0;
+        for (; j < clusters.size(); j++)
+        {
+            if (clusters[j].capacity == capacities[i] && clusters[j].max_freq_khz == max_freqs_khz[i])
+                break;
+        }
+
+        if (j == clusters.size())
+        {
+            vkpeak_cpu_cluster_info cluster;
+            cluster.capacity = capacities[i];
+            cluster.max_freq_khz = max_freqs_khz[i];
+            clusters.push_back(cluster);
+        }
+
+        clusters[j].cpus.push_back(cpus[i]);
+    }
+
+    std::stable_sort(clusters.begin(), clusters.end(), cluster_faster);
+
+    initialized = true;
+
+    return clusters;
+}
+
+int vkpeak_cpu_cluster_count()
+{
+    return (int)get_clusters().size();
+}
+
+int vkpeak_cpu_cluster_core_count(int cluster_index)
+{
+    const std::vector<vkpeak_cpu_cluster_info>& clusters = get_clusters();
+    if (cluster_index < 0 || cluster_index >= (int)clusters.size())
+        return 0;
+
+    return (int)clusters[cluster_index].cpus.size();
+}
+
+int vkpeak_cpu_cluster_max_freq(int cluster_index)
+{
+    const std::vector<vkpeak_cpu_cluster_info>& clusters = get_clusters();
+    if (cluster_index < 0 || cluster_index >= (int)clusters.size())
+        return 0;
+
+    return std::max(clusters[cluster_index].max_freq_khz / 1000, 0);
+}
+
+double vkpeak_cpu_cluster(int loop, int cmd_loop, int cluster_index, int thread_count, int arithmetic_type, int packing_type)
+{
+    const std::vector<vkpeak_cpu_cluster_info>& clusters = get_clusters();
+    if (cluster_index < 0 || cluster_index >= (int)clusters.size())
+    {
+        return 0;
+    }
+
+    const vkpeak_cpu_cluster_info& cluster = clusters[cluster_index];
+
+    if (thread_count <= 0)
+    {
+        thread_count = (int)cluster.cpus.size();
+    }
+    if (thread_count > (int)cluster.cpus.size())
+    {
+        return 0;
+    }
+
+    vkpeak_cpu_kernel kernel;
+    if (!select_kernel(arithmetic_type, packing_type, kernel))
+    {
+        return 0;
+    }
+
+    // one thread per core of the cluster
+    std::vector<int> cpus(cluster.cpus.begin(), cluster.cpus.begin() + thread_count);
+
+    return run_kernel(kernel, loop, cmd_loop, cpus);
+}
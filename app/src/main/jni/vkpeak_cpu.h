@@ -0,0 +1,35 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+#ifndef VKPEAK_CPU_H
+#define VKPEAK_CPU_H
+
+// cpu peak kernels, one translation unit per instruction set extension
+// every kernel runs loop iterations of independent multiply-add chains, enough chains to hide
+// the instruction latency on wide cores, and folds all chains into the return value so that
+// the compiler cannot drop any of them
+
+// x86
+float vkpeak_cpu_fp32_sse2(int loop);
+float vkpeak_cpu_fp32_avx2(int loop);
+float vkpeak_cpu_fp32_avx512(int loop);
+float vkpeak_cpu_int8_avxvnni(int loop);
+float vkpeak_cpu_int8_avx512vnni(int loop);
+
+// arm
+float vkpeak_cpu_fp32_neon(int loop);
+float vkpeak_cpu_fp16_asimdhp(int loop);
+float vkpeak_cpu_int8_asimddp(int loop);
+float vkpeak_cpu_int8_i8mm(int loop);
+
+#endif // VKPEAK_CPU_H
@@ -0,0 +1,105 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "vkpeak_cpu.h"
+
+#include <arm_neon.h>
+
+// 24 chains of 4 int32 lanes, each sdot does 16 s8 x s8 multiply-adds
+float vkpeak_cpu_int8_asimddp(int loop)
+{
+    int32x4_t c0 = vdupq_n_s32(0);
+    int32x4_t c1 = vdupq_n_s32(1);
+    int32x4_t c2 = vdupq_n_s32(2);
+    int32x4_t c3 = vdupq_n_s32(3);
+    int32x4_t c4 = vdupq_n_s32(4);
+    int32x4_t c5 = vdupq_n_s32(5);
+    int32x4_t c6 = vdupq_n_s32(6);
+    int32x4_t c7 = vdupq_n_s32(7);
+    int32x4_t c8 = vdupq_n_s32(8);
+    int32x4_t c9 = vdupq_n_s32(9);
+    int32x4_t ca = vdupq_n_s32(10);
+    int32x4_t cb = vdupq_n_s32(11);
+    int32x4_t cc = vdupq_n_s32(12);
+    int32x4_t cd = vdupq_n_s32(13);
+    int32x4_t ce = vdupq_n_s32(14);
+    int32x4_t cf = vdupq_n_s32(15);
+    int32x4_t cg = vdupq_n_s32(16);
+    int32x4_t ch = vdupq_n_s32(17);
+    int32x4_t ci = vdupq_n_s32(18);
+    int32x4_t cj = vdupq_n_s32(19);
+    int32x4_t ck = vdupq_n_s32(20);
+    int32x4_t cl = vdupq_n_s32(21);
+    int32x4_t cm = vdupq_n_s32(22);
+    int32x4_t cn = vdupq_n_s32(23);
+
+    // the int32 accumulators wrap around harmlessly
+    const int8x16_t a = vdupq_n_s8(3);
+    const int8x16_t b = vdupq_n_s8(-2);
+
+    for (int i = 0; i < loop; i++)
+    {
+        c0 = vdotq_s32(c0, a, b);
+        c1 = vdotq_s32(c1, a, b);
+        c2 = vdotq_s32(c2, a, b);
+        c3 = vdotq_s32(c3, a, b);
+        c4 = vdotq_s32(c4, a, b);
+        c5 = vdotq_s32(c5, a, b);
+        c6 = vdotq_s32(c6, a, b);
+        c7 = vdotq_s32(c7, a, b);
+        c8 = vdotq_s32(c8, a, b);
+        c9 = vdotq_s32(c9, a, b);
+        ca = vdotq_s32(ca, a, b);
+        cb = vdotq_s32(cb, a, b);
+        cc = vdotq_s32(cc, a, b);
+        cd = vdotq_s32(cd, a, b);
+        ce = vdotq_s32(ce, a, b);
+        cf = vdotq_s32(cf, a, b);
+        cg = vdotq_s32(cg, a, b);
+        ch = vdotq_s32(ch, a, b);
+        ci = vdotq_s32(ci, a, b);
+        cj = vdotq_s32(cj, a, b);
+        ck = vdotq_s32(ck, a, b);
+        cl = vdotq_s32(cl, a, b);
+        cm = vdotq_s32(cm, a, b);
+        cn = vdotq_s32(cn, a, b);
+    }
+
+    c0 = vaddq_s32(c0, c1);
+    c2 = vaddq_s32(c2, c3);
+    c4 = vaddq_s32(c4, c5);
+    c6 = vaddq_s32(c6, c7);
+    c8 = vaddq_s32(c8, c9);
+    ca = vaddq_s32(ca, cb);
+    cc = vaddq_s32(cc, cd);
+    ce = vaddq_s32(ce, cf);
+    cg = vaddq_s32(cg, ch);
+    ci = vaddq_s32(ci, cj);
+    ck = vaddq_s32(ck, cl);
+    cm = vaddq_s32(cm, cn);
+    c0 = vaddq_s32(c0, c2);
+    c4 = vaddq_s32(c4, c6);
+    c8 = vaddq_s32(c8, ca);
+    cc = vaddq_s32(cc, ce);
+    cg = vaddq_s32(cg, ci);
+    ck = vaddq_s32(ck, cm);
+    c0 = vaddq_s32(c0, c4);
+    c8 = vaddq_s32(c8, cc);
+    cg = vaddq_s32(cg, ck);
+    c0 = vaddq_s32(c0, c8);
+    c0 = vaddq_s32(c0, cg);
+
+    return (float)vaddvq_s32(c0);
+}
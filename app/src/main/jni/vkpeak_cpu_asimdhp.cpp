@@ -0,0 +1,105 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "vkpeak_cpu.h"
+
+#include <arm_neon.h>
+
+// 24 chains of 8 fp16 lanes out of 32 q registers
+float vkpeak_cpu_fp16_asimdhp(int loop)
+{
+    float16x8_t c0 = vdupq_n_f16((__fp16)0.0f);
+    float16x8_t c1 = vdupq_n_f16((__fp16)0.1f);
+    float16x8_t c2 = vdupq_n_f16((__fp16)0.2f);
+    float16x8_t c3 = vdupq_n_f16((__fp16)0.3f);
+    float16x8_t c4 = vdupq_n_f16((__fp16)0.4f);
+    float16x8_t c5 = vdupq_n_f16((__fp16)0.5f);
+    float16x8_t c6 = vdupq_n_f16((__fp16)0.6f);
+    float16x8_t c7 = vdupq_n_f16((__fp16)0.7f);
+    float16x8_t c8 = vdupq_n_f16((__fp16)0.8f);
+    float16x8_t c9 = vdupq_n_f16((__fp16)0.9f);
+    float16x8_t ca = vdupq_n_f16((__fp16)1.0f);
+    float16x8_t cb = vdupq_n_f16((__fp16)1.1f);
+    float16x8_t cc = vdupq_n_f16((__fp16)1.2f);
+    float16x8_t cd = vdupq_n_f16((__fp16)1.3f);
+    float16x8_t ce = vdupq_n_f16((__fp16)1.4f);
+    float16x8_t cf = vdupq_n_f16((__fp16)1.5f);
+    float16x8_t cg = vdupq_n_f16((__fp16)1.6f);
+    float16x8_t ch = vdupq_n_f16((__fp16)1.7f);
+    float16x8_t ci = vdupq_n_f16((__fp16)1.8f);
+    float16x8_t cj = vdupq_n_f16((__fp16)1.9f);
+    float16x8_t ck = vdupq_n_f16((__fp16)2.0f);
+    float16x8_t cl = vdupq_n_f16((__fp16)2.1f);
+    float16x8_t cm = vdupq_n_f16((__fp16)2.2f);
+    float16x8_t cn = vdupq_n_f16((__fp16)2.3f);
+
+    // c = c * 0.5 + 0.25 converges to 0.5
+    const float16x8_t a = vdupq_n_f16((__fp16)0.5f);
+    const float16x8_t b = vdupq_n_f16((__fp16)0.25f);
+
+    for (int i = 0; i < loop; i++)
+    {
+        c0 = vfmaq_f16(b, c0, a);
+        c1 = vfmaq_f16(b, c1, a);
+        c2 = vfmaq_f16(b, c2, a);
+        c3 = vfmaq_f16(b, c3, a);
+        c4 = vfmaq_f16(b, c4, a);
+        c5 = vfmaq_f16(b, c5, a);
+        c6 = vfmaq_f16(b, c6, a);
+        c7 = vfmaq_f16(b, c7, a);
+        c8 = vfmaq_f16(b, c8, a);
+        c9 = vfmaq_f16(b, c9, a);
+        ca = vfmaq_f16(b, ca, a);
+        cb = vfmaq_f16(b, cb, a);
+        cc = vfmaq_f16(b, cc, a);
+        cd = vfmaq_f16(b, cd, a);
+        ce = vfmaq_f16(b, ce, a);
+        cf = vfmaq_f16(b, cf, a);
+        cg = vfmaq_f16(b, cg, a);
+        ch = vfmaq_f16(b, ch, a);
+        ci = vfmaq_f16(b, ci, a);
+        cj = vfmaq_f16(b, cj, a);
+        ck = vfmaq_f16(b, ck, a);
+        cl = vfmaq_f16(b, cl, a);
+        cm = vfmaq_f16(b, cm, a);
+        cn = vfmaq_f16(b, cn, a);
+    }
+
+    c0 = vaddq_f16(c0, c1);
+    c2 = vaddq_f16(c2, c3);
+    c4 = vaddq_f16(c4, c5);
+    c6 = vaddq_f16(c6, c7);
+    c8 = vaddq_f16(c8, c9);
+    ca = vaddq_f16(ca, cb);
+    cc = vaddq_f16(cc, cd);
+    ce = vaddq_f16(ce, cf);
+    cg = vaddq_f16(cg, ch);
+    ci = vaddq_f16(ci, cj);
+    ck = vaddq_f16(ck, cl);
+    cm = vaddq_f16(cm, cn);
+    c0 = vaddq_f16(c0, c2);
+    c4 = vaddq_f16(c4, c6);
+    c8 = vaddq_f16(c8, ca);
+    cc = vaddq_f16(cc, ce);
+    cg = vaddq_f16(cg, ci);
+    ck = vaddq_f16(ck, cm);
+    c0 = vaddq_f16(c0, c4);
+    c8 = vaddq_f16(c8, cc);
+    cg = vaddq_f16(cg, ck);
+    c0 = vaddq_f16(c0, c8);
+    c0 = vaddq_f16(c0, cg);
+
+    return vaddvq_f32(vaddq_f32(vcvt_f32_f16(vget_low_f16(c0)), vcvt_f32_f16(vget_high_f16(c0))));
+}
@@ -0,0 +1,61 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+#include "vkpeak_cpu.h"
+
+#include <immintrin.h>
+
+// 12 chains of 8 lanes, 2 fma ports with 4 cycles latency need at least 8
+float vkpeak_cpu_fp32_avx2(int loop)
+{
+    __m256 c0 = _mm256_set1_ps(0.f);
+    __m256 c1 = _mm256_set1_ps(0.1f);
+    __m256 c2 = _mm256_set1_ps(0.2f);
+    __m256 c3 = _mm256_set1_ps(0.3f);
+    __m256 c4 = _mm256_set1_ps(0.4f);
+    __m256 c5 = _mm256_set1_ps(0.5f);
+    __m256 c6 = _mm256_set1_ps(0.6f);
+    __m256 c7 = _mm256_set1_ps(0.7f);
+    __m256 c8 = _mm256_set1_ps(0.8f);
+    __m256 c9 = _mm256_set1_ps(0.9f);
+    __m256 ca = _mm256_set1_ps(1.0f);
+    __m256 cb = _mm256_set1_ps(1.1f);
+
+    // c = c * 0.5 + 0.25 converges to 0.5
+    const __m256 a = _mm256_set1_ps(0.5f);
+    const __m256 b = _mm256_set1_ps(0.25f);
+
+    for (int i = 0; i < loop; i++)
+    {
+        c0 = _mm256_fmadd_ps(c0, a, b);
+        c1 = _mm256_fmadd_ps(c1, a, b);
+        c2 = _mm256_fmadd_ps(c2, a, b);
+        c3 = _mm256_fmadd_ps(c3, a, b);
+        c4 = _mm256_fmadd_ps(c4, a, b);
+        c5 = _mm256_fmadd_ps(c5, a, b);
+        c6 = _mm256_fmadd_ps(c6, a, b);
+        c7 = _mm256_fmadd_ps(c7, a, b);
+        c8 = _mm256_fmadd_ps(c8, a, b);
+        c9 = _mm256_fmadd_ps(c9, a, b);
+        ca = _mm256_fmadd_ps(ca, a, b);
+        cb = _mm256_fmadd_ps(cb, a, b);
+    }
+
+    __m256 s = _mm256_add_ps(_mm256_add_ps(_mm256_add_ps(c0, c1), _mm256_add_ps(c2, c3)), _mm256_add_ps(_mm256_add_ps(c4, c5), _mm256_add_ps(c6, c7)));
+    s = _mm256_add_ps(s, _mm256_add_ps(_mm256_add_ps(c8, c9), _mm256_add_ps(ca, cb)));
+
+    float tmp[8];
+    _mm256_storeu_ps(tmp, s);
+
+    return tmp[0] + tmp[1] + tmp[2] + tmp[3] + tmp[4] + tmp[5] + tmp[6] + tmp[7];
+}
@@ -0,0 +1,105 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "vkpeak_cpu.h"
+
+#include <immintrin.h>
+
+// 24 chains of 16 lanes out of 32 zmm registers
+float vkpeak_cpu_fp32_avx512(int loop)
+{
+    __m512 c0 = _mm512_set1_ps(0.0f);
+    __m512 c1 = _mm512_set1_ps(0.1f);
+    __m512 c2 = _mm512_set1_ps(0.2f);
+    __m512 c3 = _mm512_set1_ps(0.3f);
+    __m512 c4 = _mm512_set1_ps(0.4f);
+    __m512 c5 = _mm512_set1_ps(0.5f);
+    __m512 c6 = _mm512_set1_ps(0.6f);
+    __m512 c7 = _mm512_set1_ps(0.7f);
+    __m512 c8 = _mm512_set1_ps(0.8f);
+    __m512 c9 = _mm512_set1_ps(0.9f);
+    __m512 ca = _mm512_set1_ps(1.0f);
+    __m512 cb = _mm512_set1_ps(1.1f);
+    __m512 cc = _mm512_set1_ps(1.2f);
+    __m512 cd = _mm512_set1_ps(1.3f);
+    __m512 ce = _mm512_set1_ps(1.4f);
+    __m512 cf = _mm512_set1_ps(1.5f);
+    __m512 cg = _mm512_set1_ps(1.6f);
+    __m512 ch = _mm512_set1_ps(1.7f);
+    __m512 ci = _mm512_set1_ps(1.8f);
+    __m512 cj = _mm512_set1_ps(1.9f);
+    __m512 ck = _mm512_set1_ps(2.0f);
+    __m512 cl = _mm512_set1_ps(2.1f);
+    __m512 cm = _mm512_set1_ps(2.2f);
+    __m512 cn = _mm512_set1_ps(2.3f);
+
+    // c = c * 0.5 + 0.25 converges to 0.5
+    const __m512 a = _mm512_set1_ps(0.5f);
+    const __m512 b = _mm512_set1_ps(0.25f);
+
+    for (int i = 0; i < loop; i++)
+    {
+        c0 = _mm512_fmadd_ps(c0, a, b);
+        c1 = _mm512_fmadd_ps(c1, a, b);
+        c2 = _mm512_fmadd_ps(c2, a, b);
+        c3 = _mm512_fmadd_ps(c3, a, b);
+        c4 = _mm512_fmadd_ps(c4, a, b);
+        c5 = _mm512_fmadd_ps(c5, a, b);
+        c6 = _mm512_fmadd_ps(c6, a, b);
+        c7 = _mm512_fmadd_ps(c7, a, b);
+        c8 = _mm512_fmadd_ps(c8, a, b);
+        c9 = _mm512_fmadd_ps(c9, a, b);
+        ca = _mm512_fmadd_ps(ca, a, b);
+        cb = _mm512_fmadd_ps(cb, a, b);
+        cc = _mm512_fmadd_ps(cc, a, b);
+        cd = _mm512_fmadd_ps(cd, a, b);
+        ce = _mm512_fmadd_ps(ce, a, b);
+        cf = _mm512_fmadd_ps(cf, a, b);
+        cg = _mm512_fmadd_ps(cg, a, b);
+        ch = _mm512_fmadd_ps(ch, a, b);
+        ci = _mm512_fmadd_ps(ci, a, b);
+        cj = _mm512_fmadd_ps(cj, a, b);
+        ck = _mm512_fmadd_ps(ck, a, b);
+        cl = _mm512_fmadd_ps(cl, a, b);
+        cm = _mm512_fmadd_ps(cm, a, b);
+        cn = _mm512_fmadd_ps(cn, a, b);
+    }
+
+    c0 = _mm512_add_ps(c0, c1);
+    c2 = _mm512_add_ps(c2, c3);
+    c4 = _mm512_add_ps(c4, c5);
+    c6 = _mm512_add_ps(c6, c7);
+    c8 = _mm512_add_ps(c8, c9);
+    ca = _mm512_add_ps(ca, cb);
+    cc = _mm512_add_ps(cc, cd);
+    ce = _mm512_add_ps(ce, cf);
+    cg = _mm512_add_ps(cg, ch);
+    ci = _mm512_add_ps(ci, cj);
+    ck = _mm512_add_ps(ck, cl);
+    cm = _mm512_add_ps(cm, cn);
+    c0 = _mm512_add_ps(c0, c2);
+    c4 = _mm512_add_ps(c4, c6);
+    c8 = _mm512_add_ps(c8, ca);
+    cc = _mm512_add_ps(cc, ce);
+    cg = _mm512_add_ps(cg, ci);
+    ck = _mm512_add_ps(ck, cm);
+    c0 = _mm512_add_ps(c0, c4);
+    c8 = _mm512_add_ps(c8, cc);
+    cg = _mm512_add_ps(cg, ck);
+    c0 = _mm512_add_ps(c0, c8);
+    c0 = _mm512_add_ps(c0, cg);
+
+    return _mm512_reduce_add_ps(c0);
+}
@@ -0,0 +1,105 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "vkpeak_cpu.h"
+
+#include <immintrin.h>
+
+// 24 chains of 16 int32 lanes, each vpdpbusd does 64 u8 x s8 multiply-adds
+float vkpeak_cpu_int8_avx512vnni(int loop)
+{
+    __m512i c0 = _mm512_set1_epi32(0);
+    __m512i c1 = _mm512_set1_epi32(1);
+    __m512i c2 = _mm512_set1_epi32(2);
+    __m512i c3 = _mm512_set1_epi32(3);
+    __m512i c4 = _mm512_set1_epi32(4);
+    __m512i c5 = _mm512_set1_epi32(5);
+    __m512i c6 = _mm512_set1_epi32(6);
+    __m512i c7 = _mm512_set1_epi32(7);
+    __m512i c8 = _mm512_set1_epi32(8);
+    __m512i c9 = _mm512_set1_epi32(9);
+    __m512i ca = _mm512_set1_epi32(10);
+    __m512i cb = _mm512_set1_epi32(11);
+    __m512i cc = _mm512_set1_epi32(12);
+    __m512i cd = _mm512_set1_epi32(13);
+    __m512i ce = _mm512_set1_epi32(14);
+    __m512i cf = _mm512_set1_epi32(15);
+    __m512i cg = _mm512_set1_epi32(16);
+    __m512i ch = _mm512_set1_epi32(17);
+    __m512i ci = _mm512_set1_epi32(18);
+    __m512i cj = _mm512_set1_epi32(19);
+    __m512i ck = _mm512_set1_epi32(20);
+    __m512i cl = _mm512_set1_epi32(21);
+    __m512i cm = _mm512_set1_epi32(22);
+    __m512i cn = _mm512_set1_epi32(23);
+
+    // u8 x s8, the int32 accumulators wrap around harmlessly
+    const __m512i a = _mm512_set1_epi8(3);
+    const __m512i b = _mm512_set1_epi8(-2);
+
+    for (int i = 0; i < loop; i++)
+    {
+        c0 = _mm512_dpbusd_epi32(c0, a, b);
+        c1 = _mm512_dpbusd_epi32(c1, a, b);
+        c2 = _mm512_dpbusd_epi32(c2, a, b);
+        c3 = _mm512_dpbusd_epi32(c3, a, b);
+        c4 = _mm512_dpbusd_epi32(c4, a, b);
+        c5 = _mm512_dpbusd_epi32(c5, a, b);
+        c6 = _mm512_dpbusd_epi32(c6, a, b);
+        c7 = _mm512_dpbusd_epi32(c7, a, b);
+        c8 = _mm512_dpbusd_epi32(c8, a, b);
+        c9 = _mm512_dpbusd_epi32(c9, a, b);
+        ca = _mm512_dpbusd_epi32(ca, a, b);
+        cb = _mm512_dpbusd_epi32(cb, a, b);
+        cc = _mm512_dpbusd_epi32(cc, a, b);
+        cd = _mm512_dpbusd_epi32(cd, a, b);
+        ce = _mm512_dpbusd_epi32(ce, a, b);
+        cf = _mm512_dpbusd_epi32(cf, a, b);
+        cg = _mm512_dpbusd_epi32(cg, a, b);
+        ch = _mm512_dpbusd_epi32(ch, a, b);
+        ci = _mm512_dpbusd_epi32(ci, a, b);
+        cj = _mm512_dpbusd_epi32(cj, a, b);
+        ck = _mm512_dpbusd_epi32(ck, a, b);
+        cl = _mm512_dpbusd_epi32(cl, a, b);
+        cm = _mm512_dpbusd_epi32(cm, a, b);
+        cn = _mm512_dpbusd_epi32(cn, a, b);
+    }
+
+    c0 = _mm512_add_epi32(c0, c1);
+    c2 = _mm512_add_epi32(c2, c3);
+    c4 = _mm512_add_epi32(c4, c5);
+    c6 = _mm512_add_epi32(c6, c7);
+    c8 = _mm512_add_epi32(c8, c9);
+    ca = _mm512_add_epi32(ca, cb);
+    cc = _mm512_add_epi32(cc, cd);
+    ce = _mm512_add_epi32(ce, cf);
+    cg = _mm512_add_epi32(cg, ch);
+    ci = _mm512_add_epi32(ci, cj);
+    ck = _mm512_add_epi32(ck, cl);
+    cm = _mm512_add_epi32(cm, cn);
+    c0 = _mm512_add_epi32(c0, c2);
+    c4 = _mm512_add_epi32(c4, c6);
+    c8 = _mm512_add_epi32(c8, ca);
+    cc = _mm512_add_epi32(cc, ce);
+    cg = _mm512_add_epi32(cg, ci);
+    ck = _mm512_add_epi32(ck, cm);
+    c0 = _mm512_add_epi32(c0, c4);
+    c8 = _mm512_add_epi32(c8, cc);
+    cg = _mm512_add_epi32(cg, ck);
+    c0 = _mm512_add_epi32(c0, c8);
+    c0 = _mm512_add_epi32(c0, cg);
+
+    return (float)_mm512_reduce_add_epi32(c0);
+}
@@ -0,0 +1,74 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+
+#include "vkpeak_cpu.h"
+
+#include <immintrin.h>
+
+// 12 chains of 8 int32 lanes, each vpdpbusd does 32 u8 x s8 multiply-adds
+float vkpeak_cpu_int8_avxvnni(int loop)
+{
+    __m256i c0 = _mm256_set1_epi32(0);
+    __m256i c1 = _mm256_set1_epi32(1);
+    __m256i c2 = _mm256_set1_epi32(2);
+    __m256i c3 = _mm256_set1_epi32(3);
+    __m256i c4 = _mm256_set1_epi32(4);
+    __m256i c5 = _mm256_set1_epi32(5);
+    __m256i c6 = _mm256_set1_epi32(6);
+    __m256i c7 = _mm256_set1_epi32(7);
+    __m256i c8 = _mm256_set1_epi32(8);
+    __m256i c9 = _mm256_set1_epi32(9);
+    __m256i ca = _mm256_set1_epi32(10);
+    __m256i cb = _mm256_set1_epi32(11);
+
+    // u8 x s8, the int32 accumulators wrap around harmlessly
+    const __m256i a = _mm256_set1_epi8(3);
+    const __m256i b = _mm256_set1_epi8(-2);
+
+    for (int i = 0; i < loop; i++)
+    {
+        c0 = _mm256_dpbusd_avx_epi32(c0, a, b);
+        c1 = _mm256_dpbusd_avx_epi32(c1, a, b);
+        c2 = _mm256_dpbusd_avx_epi32(c2, a, b);
+        c3 = _mm256_dpbusd_avx_epi32(c3, a, b);
+        c4 = _mm256_dpbusd_avx_epi32(c4, a, b);
+        c5 = _mm256_dpbusd_avx_epi32(c5, a, b);
+        c6 = _mm256_dpbusd_avx_epi32(c6, a, b);
+        c7 = _mm256_dpbusd_avx_epi32(c7, a, b);
+        c8 = _mm256_dpbusd_avx_epi32(c8, a, b);
+        c9 = _mm256_dpbusd_avx_epi32(c9, a, b);
+        ca = _mm256_dpbusd_avx_epi32(ca, a, b);
+        cb = _mm256_dpbusd_avx_epi32(cb, a, b);
+    }
+
+    c0 = _mm256_add_epi32(c0, c1);
+    c2 = _mm256_add_epi32(c2, c3);
+    c4 = _mm256_add_epi32(c4, c5);
+    c6 = _mm256_add_epi32(c6, c7);
+    c8 = _mm256_add_epi32(c8, c9);
+    ca = _mm256_add_epi32(ca, cb);
+    c0 = _mm256_add_epi32(c0, c2);
+    c4 = _mm256_add_epi32(c4, c6);
+    c8 = _mm256_add_epi32(c8, ca);
+    c0 = _mm256_add_epi32(c0, c4);
+    c0 = _mm256_add_epi32(c0, c8);
+
+    // reduce in register, the lanes wrap and a scalar int sum would overflow
+    __m128i s = _mm_add_epi32(_mm256_castsi256_si128(c0), _mm256_extracti128_si256(c0, 1));
+    s = _mm_hadd_epi32(s, s);
+    s = _mm_hadd_epi32(s, s);
+
+    return (float)_mm_cvtsi128_si32(s);
+}
@@ -0,0 +1,265 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "vkpeak.h"
+#include "vkpeak_runner.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+// ncnn
+#include <gpu.h>
+#include <mat.h>
+
+// the dot kernels share one body, CT is the accumulator type and STEP one packed dot on c
+// the accumulator is fed back as the a operand, a loop invariant a * b would let the compiler
+// hoist the dot out of the loop and leave only the accumulate
+static const char glsl_dot_data[] = R"(
+layout (constant_id = 0) const int loop = 1;
+
+layout (binding = 0) writeonly buffer c_blob { int c_blob_data[]; };
+
+void main()
+{
+    const uint gx = gl_GlobalInvocationID.x;
+    const uint lx = gl_LocalInvocationID.x;
+
+    CT c = CT(gx);
+
+    const BT b = BT(lx * 0x01010101u);
+
+    for (int i = 0; i < loop; i++)
+    {
+        c = STEP(c, b);
+        c = STEP(c, b);
+        c = STEP(c, b);
+        c = STEP(c, b);
+        c = STEP(c, b);
+        c = STEP(c, b);
+        c = STEP(c, b);
+        c = STEP(c, b);
+        c = STEP(c, b);
+        c = STEP(c, b);
+        c = STEP(c, b);
+        c = STEP(c, b);
+        c = STEP(c, b);
+        c = STEP(c, b);
+        c = STEP(c, b);
+        c = STEP(c, b);
+    }
+
+    c_blob_data[gx] = int(c);
+}
+)";
+
+static const char glsl_dot_dual_data[] = R"(
+layout (constant_id = 0) const int loop = 1;
+
+layout (binding = 0) writeonly buffer c_blob { int c_blob_data[]; };
+
+void main()
+{
+    const uint gx = gl_GlobalInvocationID.x;
+    const uint lx = gl_LocalInvocationID.x;
+
+    CT c0 = CT(gx);
+    CT c1 = CT(lx);
+
+    const BT b = BT(lx * 0x01010101u);
+
+    for (int i = 0; i < loop; i++)
+    {
+        c0 = STEP(c0, b);
+        c1 = STEP(c1, b);
+        c0 = STEP(c0, b);
+        c1 = STEP(c1, b);
+        c0 = STEP(c0, b);
+        c1 = STEP(c1, b);
+        c0 = STEP(c0, b);
+        c1 = STEP(c1, b);
+        c0 = STEP(c0, b);
+        c1 = STEP(c1, b);
+        c0 = STEP(c0, b);
+        c1 = STEP(c1, b);
+        c0 = STEP(c0, b);
+        c1 = STEP(c1, b);
+        c0 = STEP(c0, b);
+        c1 = STEP(c1, b);
+    }
+
+    c_blob_data[gx] = int(c0 + c1);
+}
+)";
+
+// a b and c types of signed unsigned and mixed, the mixed dot takes a signed and b unsigned
+static const char* const dot_type_defines[3][3] = {
+    {"int", "int", "int"},
+    {"uint", "uint", "uint"},
+    {"int", "uint", "int"},
+};
+
+static std::string build_dot_glsl(const char* body, int signedness_type, int saturating, int packing_type)
+{
+    std::string glsl = "#version 450\n";
+
+    glsl += "#extension GL_EXT_integer_dot_product: require\n";
+
+    glsl += std::string("#define AT ") + dot_type_defines[signedness_type][0] + "\n";
+    glsl += std::string("#define BT ") + dot_type_defines[signedness_type][1] + "\n";
+    glsl += std::string("#define CT ") + dot_type_defines[signedness_type][2] + "\n";
+
+    if (saturating)
+        glsl += "#define DOT(x, b, c) dotPacked4x8AccSatEXT(AT(x), b, c)\n";
+    else
+        glsl += "#define DOT(x, b, c) (dotPacked4x8EXT(AT(x), b) + c)\n";
+
+    if (packing_type == 8)
+    {
+        // eight 4 bit values per uint, the low and high nibbles are spread into two 4x8 words
+        // a signed a operand has bit 3 of every nibble copied into the upper half of its byte
+        if (signedness_type == 1)
+            glsl += "#define NIBBLE(v) ((v) & CT(0x0f0f0f0f))\n";
+        else
+            glsl += "#define NIBBLE(v) (((v) & CT(0x0f0f0f0f)) | (((v) & CT(0x08080808)) * CT(0x1e)))\n";
+
+        glsl += "#define STEP(x, b) DOT(NIBBLE(x >> 4), b, DOT(NIBBLE(x), b, x))\n";
+    }
+    else // if (packing_type == 4)
+    {
+        glsl += "#define STEP(x, b) DOT(x, b, x)\n";
+    }
+
+    glsl += body;
+
+    return glsl;
+}
+
+int vkpeak_dot_accelerated(int signedness_type, int saturating)
+{
+    ncnn::VulkanDevice* vkdev = vkpeak_get_device();
+
+    if (!vkdev)
+    {
+        return 0;
+    }
+
+    if (!vkdev->info.queryShaderIntegerDotProductFeatures().shaderIntegerDotProduct)
+    {
+        return 0;
+    }
+
+    const VkPhysicalDeviceShaderIntegerDotProductProperties& properties = vkdev->info.queryShaderIntegerDotProductProperties();
+
+    VkBool32 accelerated = 0;
+    if (saturating)
+    {
+        if (signedness_type == 0)
+            accelerated = properties.integerDotProductAccumulatingSaturating4x8BitPackedSignedAccelerated;
+        if (signedness_type == 1)
+            accelerated = properties.integerDotProductAccumulatingSaturating4x8BitPackedUnsignedAccelerated;
+        if (signedness_type == 2)
+            accelerated = properties.integerDotProductAccumulatingSaturating4x8BitPackedMixedSignednessAccelerated;
+    }
+    else
+    {
+        if (signedness_type == 0)
+            accelerated = properties.integerDotProduct4x8BitPackedSignedAccelerated;
+        if (signedness_type == 1)
+            accelerated = properties.integerDotProduct4x8BitPackedUnsignedAccelerated;
+        if (signedness_type == 2)
+            accelerated = properties.integerDotProduct4x8BitPackedMixedSignednessAccelerated;
+    }
+
+    return accelerated ? 1 : 0;
+}
+
+double vkpeak_dot(int loop, int count_mb, int cmd_loop, int signedness_type, int saturating, int packing_type)
+{
+    ncnn::VulkanDevice* vkdev = vkpeak_get_device();
+
+    if (!vkdev)
+    {
+        return 0;
+    }
+
+    if (signedness_type < 0 || signedness_type > 2)
+    {
+        return 0;
+    }
+    if (saturating != 0 && saturating != 1)
+    {
+        return 0;
+    }
+    if (packing_type != 4 && packing_type != 8)
+    {
+        return 0;
+    }
+
+    // check shader int8 dotprod feature
+    if (!vkdev->info.queryShaderIntegerDotProductFeatures().shaderIntegerDotProduct)
+    {
+        return 0;
+    }
+
+    ncnn::Option opt;
+    opt.use_vulkan_compute = true;
+    opt.use_fp16_packed = false;
+    opt.use_fp16_storage = false;
+    opt.use_fp16_arithmetic = false;
+
+    // packing_type multiply adds per statement, the nibble unpack is not counted
+    vkpeak_kernel kernel;
+    kernel.glsl = build_dot_glsl(glsl_dot_data, signedness_type, saturating, packing_type);
+    kernel.ops_per_loop = 16 * 2 * packing_type;
+    kernel.ops_tail = 0;
+
+    vkpeak_kernel kernel_dual;
+    kernel_dual.glsl = build_dot_glsl(glsl_dot_dual_data, signedness_type, saturating, packing_type);
+    kernel_dual.ops_per_loop = 16 * 2 * packing_type;
+    kernel_dual.ops_tail = 1; // +1 for the tail c0+c1
+
+    ncnn::VkAllocator* allocator = vkdev->acquire_blob_allocator();
+
+    int buffer_size = vkpeak_buffer_size(vkdev, count_mb);
+
+    ncnn::VkMat c(buffer_size, (size_t)1u, 1, allocator);
+
+    int local_size_x = vkpeak_local_size(vkdev, std::min(128, std::max(1, (int)vkdev->info.subgroup_size())));
+
+    int max_invocation_count = buffer_size / 4;
+    // make max_invocation_count be multiple of local_size_x
+    max_invocation_count = std::max(max_invocation_count / local_size_x, 1) * local_size_x;
+
+    // start with little works
+    int invocation_count = std::max(max_invocation_count / 32 / local_size_x, 1) * local_size_x;
+
+    vkpeak_workload workload;
+    workload.vkdev = vkdev;
+    workload.opt = opt;
+    workload.kernels.push_back(kernel);
+    workload.kernels.push_back(kernel_dual);
+    workload.specializations.resize(1);
+    workload.bindings.push_back(c);
+    workload.local_size_x = local_size_x;
+    workload.invocation_count = invocation_count;
+    workload.max_invocation_count = max_invocation_count;
+    workload.split_queues = true;
+
+    double max_gops = vkpeak_run(workload, loop, cmd_loop);
+
+    vkdev->reclaim_blob_allocator(allocator);
+
+    return max_gops;
+}
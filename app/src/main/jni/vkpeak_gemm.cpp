@@ -0,0 +1,392 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "vkpeak.h"
+#include "vkpeak_runner.h"
+
+#include <algorithm>
+#include <vector>
+
+// ncnn
+#include <command.h>
+#include <gpu.h>
+#include <mat.h>
+
+// c = a * b with row major a M x K, b K x N and c M x N, M N K already padded to the tile sizes
+// every workgroup of 256 computes a 64 x 64 tile of c, 4 rows by 4 strided columns per invocation,
+// and walks K in 16 deep slices of a and b staged in shared memory
+// the whole k walk runs loop times into the same accumulators
+static const char glsl_gemm_tiled_data[] = R"(
+#version 450
+
+layout (constant_id = 0) const int loop = 1;
+layout (constant_id = 1) const int M = 1;
+layout (constant_id = 2) const int N = 1;
+layout (constant_id = 3) const int K = 1;
+
+layout (binding = 0) readonly buffer a_blob { sfp a_blob_data[]; };
+layout (binding = 1) readonly buffer b_blob { sfp b_blob_data[]; };
+layout (binding = 2) writeonly buffer c_blob { sfp c_blob_data[]; };
+
+// k major, a row of tmp_a is one k of 64 rows of a
+shared afp tmp_a[16][64];
+shared afp tmp_b[16][64];
+
+void main()
+{
+    const int lx = int(gl_LocalInvocationID.x);
+
+    const int tiles_n = N / 64;
+    const int tm = int(gl_WorkGroupID.x) / tiles_n * 64;
+    const int tn = int(gl_WorkGroupID.x) % tiles_n * 64;
+
+    // 4 consecutive rows and the columns tx tx+16 tx+32 tx+48
+    const int tx = lx % 16;
+    const int ty = lx / 16 * 4;
+
+    afpvec4 sum0 = afpvec4(0.f);
+    afpvec4 sum1 = afpvec4(0.f);
+    afpvec4 sum2 = afpvec4(0.f);
+    afpvec4 sum3 = afpvec4(0.f);
+
+    for (int l = 0; l < loop; l++)
+    {
+        for (int k0 = 0; k0 < K; k0 += 16)
+        {
+            // 64 x 16 of a and 16 x 64 of b, 4 elements of each per invocation
+            for (int i = 0; i < 4; i++)
+            {
+                const int e = lx + i * 256;
+
+                const int ar = e / 16;
+                const int ac = e % 16;
+                tmp_a[ac][ar] = afp(a_blob_data[(tm + ar) * K + k0 + ac]);
+
+                const int br = e / 64;
+                const int bc = e % 64;
+                tmp_b[br][bc] = afp(b_blob_data[(k0 + br) * N + tn + bc]);
+            }
+
+            barrier();
+
+            for (int k = 0; k < 16; k++)
+            {
+                const afpvec4 b = afpvec4(tmp_b[k][tx], tmp_b[k][tx + 16], tmp_b[k][tx + 32], tmp_b[k][tx + 48]);
+
+                sum0 += tmp_a[k][ty] * b;
+                sum1 += tmp_a[k][ty + 1] * b;
+                sum2 += tmp_a[k][ty + 2] * b;
+                sum3 += tmp_a[k][ty + 3] * b;
+            }
+
+            barrier();
+        }
+    }
+
+    const afpvec4 sums[4] = afpvec4[4](sum0, sum1, sum2, sum3);
+    for (int i = 0; i < 4; i++)
+    {
+        const int gi = (tm + ty + i) * N + tn + tx;
+        c_blob_data[gi] = sfp(sums[i].x);
+        c_blob_data[gi + 16] = sfp(sums[i].y);
+        c_blob_data[gi + 32] = sfp(sums[i].z);
+        c_blob_data[gi + 48] = sfp(sums[i].w);
+    }
+}
+)";
+
+// fp16 a and b loaded straight from the buffers as cooperative matrices
+// every subgroup computes a 2 x 2 block of TM x TN tiles of c and reuses each a and b fragment twice
+// CT is the accumulator type of the configuration the fp16 matrix peak test uses
+static const char glsl_gemm_matrix_data[] = R"(
+#extension GL_EXT_shader_explicit_arithmetic_types_float16: require
+#extension GL_EXT_shader_16bit_storage: require
+#extension GL_KHR_memory_scope_semantics: require
+#extension GL_EXT_shader_explicit_arithmetic_types: require
+#extension GL_KHR_cooperative_matrix: require
+#extension GL_KHR_shader_subgroup_basic: require
+
+layout (constant_id = 0) const int loop = 1;
+layout (constant_id = 1) const int M = 1;
+layout (constant_id = 2) const int N = 1;
+layout (constant_id = 3) const int K = 1;
+layout (constant_id = 4) const int TM = 1;
+layout (constant_id = 5) const int TN = 1;
+layout (constant_id = 6) const int TK = 1;
+
+layout (binding = 0) readonly buffer a_blob { float16_t a_blob_data[]; };
+layout (binding = 1) readonly buffer b_blob { float16_t b_blob_data[]; };
+layout (binding = 2) writeonly buffer c_blob { CT c_blob_data[]; };
+
+void main()
+{
+    const int blocks_n = N / (TN * 2);
+    const int block_count = M / (TM * 2) * blocks_n;
+
+    // walk the blocks with a subgroup stride, a driver that runs wider subgroups than the reported
+    // subgroup size has fewer subgroups per workgroup but still computes every block
+    const int block_stride = int(gl_NumWorkGroups.x * gl_NumSubgroups);
+
+    for (int block = int(gl_WorkGroupID.x * gl_NumSubgroups + gl_SubgroupID); block < block_count; block += block_stride)
+    {
+        const int bm = block / blocks_n * (TM * 2);
+        const int bn = block % blocks_n * (TN * 2);
+
+        coopmat<CT, gl_ScopeSubgroup, TM, TN, gl_MatrixUseAccumulator> c00 = coopmat<CT, gl_ScopeSubgroup, TM, TN, gl_MatrixUseAccumulator>(0.f);
+        coopmat<CT, gl_ScopeSubgroup, TM, TN, gl_MatrixUseAccumulator> c01 = coopmat<CT, gl_ScopeSubgroup, TM, TN, gl_MatrixUseAccumulator>(0.f);
+        coopmat<CT, gl_ScopeSubgroup, TM, TN, gl_MatrixUseAccumulator> c10 = coopmat<CT, gl_ScopeSubgroup, TM, TN, gl_MatrixUseAccumulator>(0.f);
+        coopmat<CT, gl_ScopeSubgroup, TM, TN, gl_MatrixUseAccumulator> c11 = coopmat<CT, gl_ScopeSubgroup, TM, TN, gl_MatrixUseAccumulator>(0.f);
+
+        for (int l = 0; l < loop; l++)
+        {
+            for (int k = 0; k < K; k += TK)
+            {
+                coopmat<float16_t, gl_ScopeSubgroup, TM, TK, gl_MatrixUseA> a0;
+                coopmat<float16_t, gl_ScopeSubgroup, TM, TK, gl_MatrixUseA> a1;
+                coopMatLoad(a0, a_blob_data, uint(bm * K + k), uint(K), gl_CooperativeMatrixLayoutRowMajor);
+                coopMatLoad(a1, a_blob_data, uint((bm + TM) * K + k), uint(K), gl_CooperativeMatrixLayoutRowMajor);
+
+                coopmat<float16_t, gl_ScopeSubgroup, TK, TN, gl_MatrixUseB> b0;
+                coopmat<float16_t, gl_ScopeSubgroup, TK, TN, gl_MatrixUseB> b1;
+                coopMatLoad(b0, b_blob_data, uint(k * N + bn), uint(N), gl_CooperativeMatrixLayoutRowMajor);
+                coopMatLoad(b1, b_blob_data, uint(k * N + bn + TN), uint(N), gl_CooperativeMatrixLayoutRowMajor);
+
+                c00 = coopMatMulAdd(a0, b0, c00);
+                c01 = coopMatMulAdd(a0, b1, c01);
+                c10 = coopMatMulAdd(a1, b0, c10);
+                c11 = coopMatMulAdd(a1, b1, c11);
+            }
+        }
+
+        coopMatStore(c00, c_blob_data, uint(bm * N + bn), uint(N), gl_CooperativeMatrixLayoutRowMajor);
+        coopMatStore(c01, c_blob_data, uint(bm * N + bn + TN), uint(N), gl_CooperativeMatrixLayoutRowMajor);
+        coopMatStore(c10, c_blob_data, uint((bm + TM) * N + bn), uint(N), gl_CooperativeMatrixLayoutRowMajor);
+        coopMatStore(c11, c_blob_data, uint((bm + TM) * N + bn + TN), uint(N), gl_CooperativeMatrixLayoutRowMajor);
+    }
+}
+)";
+
+static int align_up(int x, int a)
+{
+    return (x + a - 1) / a * a;
+}
+
+// small values that neither overflow fp16 nor turn into denormals
+static void fill_matrix(ncnn::Mat& m, int seed)
+{
+    float* ptr = m;
+    const int size = m.w * m.h;
+    for (int i = 0; i < size; i++)
+    {
+        ptr[i] = ((i * 7 + seed) % 17 - 8) * 0.0625f;
+    }
+}
+
+// the subgroup scope fp16 matrix shape of the fp16 matrix peak test, fp16 accumulation first
+static int find_fp16_matrix_config(const ncnn::VulkanDevice* vkdev, int& TM, int& TN, int& TK, bool& fp32_accumulator)
+{
+    const std::vector<VkCooperativeMatrixPropertiesKHR>& properties = vkdev->info.queryCooperativeMatrixProperties();
+
+    for (int pass = 0; pass < 2; pass++)
+    {
+        const VkComponentTypeKHR c_type = pass == 0 ? VK_COMPONENT_TYPE_FLOAT16_KHR : VK_COMPONENT_TYPE_FLOAT32_KHR;
+
+        for (uint32_t j = 0; j < properties.size(); j++)
+        {
+            const VkCooperativeMatrixPropertiesKHR& cmp = properties[j];
+
+            if (cmp.AType == VK_COMPONENT_TYPE_FLOAT16_KHR && cmp.BType == VK_COMPONENT_TYPE_FLOAT16_KHR
+                && cmp.CType == c_type && cmp.ResultType == c_type
+                && cmp.scope == VK_SCOPE_SUBGROUP_KHR)
+            {
+                TM = cmp.MSize;
+                TN = cmp.NSize;
+                TK = cmp.KSize;
+                fp32_accumulator = pass == 1;
+                return 0;
+            }
+        }
+    }
+
+    return -1;
+}
+
+double vkpeak_gemm(int cmd_loop, int gemm_type, int M, int N, int K)
+{
+    ncnn::VulkanDevice* vkdev = vkpeak_get_device();
+
+    if (!vkdev)
+    {
+        return 0;
+    }
+
+    if (gemm_type < 0 || gemm_type > 2)
+    {
+        return 0;
+    }
+    if (M < 1 || N < 1 || K < 1)
+    {
+        return 0;
+    }
+
+    if (gemm_type == 1 && (!vkdev->info.support_fp16_storage() || !vkdev->info.support_fp16_arithmetic()))
+    {
+        return 0;
+    }
+    // the matrix kernel declares float16_t fragments, as the fp16 matrix peak test does
+    if (gemm_type == 2 && (!vkdev->info.support_fp16_storage() || !vkdev->info.support_fp16_arithmetic() || !vkdev->info.support_VK_KHR_cooperative_matrix()))
+    {
+        return 0;
+    }
+
+    const int subgroup_size = std::max(1, (int)vkdev->info.subgroup_size());
+
+    // tile sizes, and the padding of M N K to them
+    int TM = 64;
+    int TN = 64;
+    int TK = 16;
+    bool fp32_accumulator = false;
+    int local_size_x = 256;
+    if (gemm_type == 2)
+    {
+        int ret = find_fp16_matrix_config(vkdev, TM, TN, TK, fp32_accumulator);
+        if (ret != 0)
+        {
+            return 0;
+        }
+
+        // 4 subgroups of the reported size per workgroup, the kernel loops over blocks
+        // so fewer and wider subgroups still cover all of c
+        local_size_x = subgroup_size * 4;
+    }
+
+    if (local_size_x > (int)vkdev->info.max_workgroup_size_x() || local_size_x > (int)vkdev->info.max_workgroup_invocations())
+    {
+        return 0;
+    }
+
+    const int block_m = gemm_type == 2 ? TM * 2 : TM;
+    const int block_n = gemm_type == 2 ? TN * 2 : TN;
+    const int Mp = align_up(M, block_m);
+    const int Np = align_up(N, block_n);
+    const int Kp = align_up(K, TK);
+
+    const size_t elemsize = gemm_type == 0 ? 4u : 2u;
+    const size_t c_elemsize = gemm_type == 0 || (gemm_type == 2 && fp32_accumulator) ? 4u : 2u;
+
+    // every matrix must fit in the work buffer budget
+    const double max_size = vkpeak_buffer_size(vkdev, 512);
+    if ((double)Mp * Kp * elemsize > max_size || (double)Kp * Np * elemsize > max_size || (double)Mp * Np * c_elemsize > max_size)
+    {
+        return 0;
+    }
+
+    ncnn::Mat a_data(Kp, Mp);
+    ncnn::Mat b_data(Np, Kp);
+    if (a_data.empty() || b_data.empty())
+    {
+        return 0;
+    }
+
+    fill_matrix(a_data, 0);
+    fill_matrix(b_data, 5);
+
+    ncnn::VkAllocator* allocator = vkdev->acquire_blob_allocator();
+    ncnn::VkAllocator* staging_allocator = vkdev->acquire_staging_allocator();
+
+    ncnn::Option opt;
+    opt.use_vulkan_compute = true;
+    opt.use_fp16_packed = false;
+    opt.use_fp16_storage = gemm_type != 0;
+    opt.use_fp16_arithmetic = gemm_type == 1;
+    opt.use_packing_layout = false; // upload the matrices as is, row major without repacking
+    opt.blob_vkallocator = allocator;
+    opt.workspace_vkallocator = allocator;
+    opt.staging_vkallocator = staging_allocator;
+
+    // upload a and b, converted to fp16 with fp16 storage
+    ncnn::VkMat a;
+    ncnn::VkMat b;
+    {
+        ncnn::VkCompute cmd(vkdev);
+        cmd.record_upload(a_data, a, opt);
+        cmd.record_upload(b_data, b, opt);
+
+        int ret = cmd.submit_and_wait();
+        if (ret != 0 || a.empty() || b.empty())
+        {
+            vkdev->reclaim_staging_allocator(staging_allocator);
+            vkdev->reclaim_blob_allocator(allocator);
+            return 0;
+        }
+    }
+
+    a_data.release();
+    b_data.release();
+
+    ncnn::VkMat c(Mp * Np, c_elemsize, 1, allocator);
+
+    vkpeak_kernel kernel;
+    std::vector<ncnn::vk_specialization_type> specializations(4);
+    specializations[1].i = Mp;
+    specializations[2].i = Np;
+    specializations[3].i = Kp;
+
+    int invocation_count;
+    if (gemm_type == 2)
+    {
+        kernel.glsl = "#version 450\n";
+        kernel.glsl += fp32_accumulator ? "#define CT float\n" : "#define CT float16_t\n";
+        kernel.glsl += glsl_gemm_matrix_data;
+
+        specializations.resize(7);
+        specializations[4].i = TM;
+        specializations[5].i = TN;
+        specializations[6].i = TK;
+
+        const int block_count = (Mp / block_m) * (Np / block_n);
+        invocation_count = align_up(block_count, 4) / 4 * local_size_x;
+    }
+    else
+    {
+        kernel.glsl.assign(glsl_gemm_tiled_data, sizeof(glsl_gemm_tiled_data) - 1);
+
+        invocation_count = (Mp / 64) * (Np / 64) * local_size_x;
+    }
+
+    // the useful work of one k walk, the padding is wasted
+    kernel.ops_per_loop = 2.0 * M * N * K / invocation_count;
+    kernel.ops_tail = 0;
+
+    vkpeak_workload workload;
+    workload.vkdev = vkdev;
+    workload.opt = opt;
+    workload.kernels.push_back(kernel);
+    workload.specializations = specializations;
+    workload.bindings.push_back(a);
+    workload.bindings.push_back(b);
+    workload.bindings.push_back(c);
+    workload.local_size_x = local_size_x;
+    // the dispatch covers the matrix exactly, only the repeat count grows
+    workload.invocation_count = invocation_count;
+    workload.max_invocation_count = invocation_count;
+    workload.split_queues = false;
+
+    double max_gflops = vkpeak_run(workload, 1, cmd_loop);
+
+    vkdev->reclaim_staging_allocator(staging_allocator);
+    vkdev->reclaim_blob_allocator(allocator);
+
+    return max_gflops;
+}
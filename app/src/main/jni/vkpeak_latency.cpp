@@ -0,0 +1,191 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "vkpeak.h"
+#include "vkpeak_runner.h"
+
+#include <algorithm>
+#include <vector>
+
+// ncnn
+#include <command.h>
+#include <gpu.h>
+#include <mat.h>
+
+// every node of the chain owns a 64 byte line and stores the uint index of the next node
+// lane x of the walker starts at node x, all nodes are on one random cycle so the lanes never meet
+static const char glsl_latency_data[] = R"(
+#version 450
+
+layout (constant_id = 0) const int loop = 1;
+
+layout (binding = 0) readonly buffer a_blob { uint a_blob_data[]; };
+layout (binding = 1) writeonly buffer c_blob { uint c_blob_data[]; };
+
+void main()
+{
+    const uint gx = gl_GlobalInvocationID.x;
+
+    uint p = gx * 16;
+
+    for (int i = 0; i < loop; i++)
+    {
+        p = a_blob_data[p];
+        p = a_blob_data[p];
+        p = a_blob_data[p];
+        p = a_blob_data[p];
+        p = a_blob_data[p];
+        p = a_blob_data[p];
+        p = a_blob_data[p];
+        p = a_blob_data[p];
+        p = a_blob_data[p];
+        p = a_blob_data[p];
+        p = a_blob_data[p];
+        p = a_blob_data[p];
+        p = a_blob_data[p];
+        p = a_blob_data[p];
+        p = a_blob_data[p];
+        p = a_blob_data[p];
+    }
+
+    c_blob_data[gx] = p;
+}
+)";
+
+// single cycle random permutation of node_count nodes, sattolo's algorithm
+static void build_chain(ncnn::Mat& chain, int node_count)
+{
+    std::vector<int> order(node_count);
+    for (int i = 0; i < node_count; i++)
+    {
+        order[i] = i;
+    }
+
+    // fixed seed xorshift, every run walks the same chain
+    uint32_t seed = 7767517;
+    for (int i = node_count - 1; i > 0; i--)
+    {
+        seed ^= seed << 13;
+        seed ^= seed >> 17;
+        seed ^= seed << 5;
+        int j = seed % i;
+        std::swap(order[i], order[j]);
+    }
+
+    chain.fill(0);
+
+    uint32_t* ptr = chain;
+    for (int i = 0; i < node_count; i++)
+    {
+        int node = order[i];
+        int next = order[(i + 1) % node_count];
+        ptr[node * 16] = next * 16;
+    }
+}
+
+double vkpeak_latency(int loop, int cmd_loop, int footprint_kb, int walker_type)
+{
+    ncnn::VulkanDevice* vkdev = vkpeak_get_device();
+
+    if (!vkdev)
+    {
+        return 0;
+    }
+
+    if (walker_type != 0 && walker_type != 1)
+    {
+        return 0;
+    }
+
+    // chain must fit in the same budget as the work buffer of vkpeak()
+    if (footprint_kb <= 0 || footprint_kb > vkpeak_buffer_size(vkdev, 512) / 1024)
+    {
+        return 0;
+    }
+
+    // one thread or one subgroup
+    const int local_size_x = walker_type == 0 ? 1 : std::max(1, (int)vkdev->info.subgroup_size());
+
+    const int node_count = footprint_kb * 1024 / 64;
+    if (node_count < local_size_x)
+    {
+        return 0;
+    }
+
+    ncnn::Mat chain(node_count * 16, (size_t)4u);
+    if (chain.empty())
+    {
+        return 0;
+    }
+
+    build_chain(chain, node_count);
+
+    ncnn::VkAllocator* allocator = vkdev->acquire_blob_allocator();
+    ncnn::VkAllocator* staging_allocator = vkdev->acquire_staging_allocator();
+
+    ncnn::Option opt;
+    opt.use_vulkan_compute = true;
+    opt.use_fp16_packed = false;
+    opt.use_fp16_storage = false;
+    opt.use_fp16_arithmetic = false;
+    opt.use_packing_layout = false; // upload the uint chain as is, no repacking through float
+    opt.blob_vkallocator = allocator;
+    opt.workspace_vkallocator = allocator;
+    opt.staging_vkallocator = staging_allocator;
+
+    // upload chain
+    ncnn::VkMat a;
+    {
+        ncnn::VkCompute cmd(vkdev);
+        cmd.record_upload(chain, a, opt);
+
+        int ret = cmd.submit_and_wait();
+        if (ret != 0 || a.empty())
+        {
+            vkdev->reclaim_staging_allocator(staging_allocator);
+            vkdev->reclaim_blob_allocator(allocator);
+            return 0;
+        }
+    }
+
+    chain.release();
+
+    ncnn::VkMat c(local_size_x, (size_t)4u, 1, allocator);
+
+    // 16 dependent loads per loop, counted once for the whole walker
+    vkpeak_kernel kernel;
+    kernel.glsl.assign(glsl_latency_data, sizeof(glsl_latency_data) - 1);
+    kernel.ops_per_loop = 16.0 / local_size_x;
+    kernel.ops_tail = 0;
+
+    vkpeak_workload workload;
+    workload.vkdev = vkdev;
+    workload.opt = opt;
+    workload.kernels.push_back(kernel);
+    workload.specializations.resize(1);
+    workload.bindings.push_back(a);
+    workload.bindings.push_back(c);
+    workload.local_size_x = local_size_x;
+    workload.invocation_count = local_size_x;
+    workload.max_invocation_count = local_size_x;
+    workload.split_queues = false;
+
+    // dependent loads per nanosecond
+    double max_gops = vkpeak_run(workload, loop, cmd_loop);
+
+    vkdev->reclaim_staging_allocator(staging_allocator);
+    vkdev->reclaim_blob_allocator(allocator);
+
+    return max_gops > 0 ? 1.0 / max_gops : 0;
+}
@@ -0,0 +1,614 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "vkpeak.h"
+#include "vkpeak_runner.h"
+
+#include <stdio.h>
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+// ncnn
+#include <gpu.h>
+#include <mat.h>
+
+// the matrix kernels share one body, MAT_A MAT_B MAT_C are the matrix types of one advertised
+// configuration, MULADD and STORE hide the KHR and NV spelling
+// c is stored into a uint buffer, CS is the byte size of its component type
+static const char glsl_matrix_data[] = R"(
+layout (constant_id = 0) const int loop = 1;
+layout (constant_id = 1) const int M = 1;
+layout (constant_id = 2) const int N = 1;
+layout (constant_id = 3) const int K = 1;
+
+layout (binding = 0) writeonly buffer c_blob { uint c_blob_data[]; };
+
+void main()
+{
+    const uint gx = gl_GlobalInvocationID.x;
+    const uint lx = gl_LocalInvocationID.x;
+
+    MAT_A a = MAT_A(AT(float(gx & 7u)));
+    MAT_B b = MAT_B(BT(float(lx & 7u)));
+
+    MAT_C c = MAT_C(CT(float(gx & 7u)));
+
+    for (int i = 0; i < loop; i++)
+    {
+        c = MULADD(a, b, c);
+        c = MULADD(a, b, c);
+        c = MULADD(a, b, c);
+        c = MULADD(a, b, c);
+        c = MULADD(a, b, c);
+        c = MULADD(a, b, c);
+        c = MULADD(a, b, c);
+        c = MULADD(a, b, c);
+        c = MULADD(a, b, c);
+        c = MULADD(a, b, c);
+        c = MULADD(a, b, c);
+        c = MULADD(a, b, c);
+        c = MULADD(a, b, c);
+        c = MULADD(a, b, c);
+        c = MULADD(a, b, c);
+        c = MULADD(a, b, c);
+    }
+
+    STORE(c, c_blob_data, gx * (M * N) * CS / 4, N * CS / 4);
+}
+)";
+
+static const char glsl_matrix_dual_data[] = R"(
+layout (constant_id = 0) const int loop = 1;
+layout (constant_id = 1) const int M = 1;
+layout (constant_id = 2) const int N = 1;
+layout (constant_id = 3) const int K = 1;
+
+layout (binding = 0) writeonly buffer c_blob { uint c_blob_data[]; };
+
+void main()
+{
+    const uint gx = gl_GlobalInvocationID.x;
+    const uint lx = gl_LocalInvocationID.x;
+
+    MAT_A a = MAT_A(AT(float(gx & 7u)));
+    MAT_B b = MAT_B(BT(float(lx & 7u)));
+
+    MAT_C c0 = MAT_C(CT(float(gx & 7u)));
+    MAT_C c1 = MAT_C(CT(float(lx & 7u)));
+
+    for (int i = 0; i < loop; i++)
+    {
+        c0 = MULADD(a, b, c0);
+        c1 = MULADD(a, b, c1);
+        c0 = MULADD(a, b, c0);
+        c1 = MULADD(a, b, c1);
+        c0 = MULADD(a, b, c0);
+        c1 = MULADD(a, b, c1);
+        c0 = MULADD(a, b, c0);
+        c1 = MULADD(a, b, c1);
+        c0 = MULADD(a, b, c0);
+        c1 = MULADD(a, b, c1);
+        c0 = MULADD(a, b, c0);
+        c1 = MULADD(a, b, c1);
+        c0 = MULADD(a, b, c0);
+        c1 = MULADD(a, b, c1);
+        c0 = MULADD(a, b, c0);
+        c1 = MULADD(a, b, c1);
+    }
+
+    c0 = c0 + c1;
+    STORE(c0, c_blob_data, gx * (M * N) * CS / 4, N * CS / 4);
+}
+)";
+
+// component types a matrix kernel can be generated for, the NV enum values are the same
+struct vkpeak_matrix_component
+{
+    int type;
+    const char* name;
+    const char* glsl_type;
+    int size;
+    char kind; // f i u, the NV matrix type prefix
+};
+
+static const vkpeak_matrix_component matrix_components[] = {
+    {VK_COMPONENT_TYPE_FLOAT16_KHR, "fp16", "float16_t", 2, 'f'},
+    {VK_COMPONENT_TYPE_FLOAT32_KHR, "fp32", "float", 4, 'f'},
+    {VK_COMPONENT_TYPE_FLOAT64_KHR, "fp64", "double", 8, 'f'},
+    {VK_COMPONENT_TYPE_SINT8_KHR, "s8", "int8_t", 1, 'i'},
+    {VK_COMPONENT_TYPE_SINT16_KHR, "s16", "int16_t", 2, 'i'},
+    {VK_COMPONENT_TYPE_SINT32_KHR, "s32", "int", 4, 'i'},
+    {VK_COMPONENT_TYPE_SINT64_KHR, "s64", "int64_t", 8, 'i'},
+    {VK_COMPONENT_TYPE_UINT8_KHR, "u8", "uint8_t", 1, 'u'},
+    {VK_COMPONENT_TYPE_UINT16_KHR, "u16", "uint16_t", 2, 'u'},
+    {VK_COMPONENT_TYPE_UINT32_KHR, "u32", "uint", 4, 'u'},
+    {VK_COMPONENT_TYPE_UINT64_KHR, "u64", "uint64_t", 8, 'u'},
+    {VK_COMPONENT_TYPE_BFLOAT16_KHR, "bf16", "bfloat16_t", 2, 'f'},
+    {VK_COMPONENT_TYPE_FLOAT8_E4M3_EXT, "e4m3", "floate4m3_t", 1, 'f'},
+    {VK_COMPONENT_TYPE_FLOAT8_E5M2_EXT, "e5m2", "floate5m2_t", 1, 'f'},
+};
+
+static const vkpeak_matrix_component* find_matrix_component(int type)
+{
+    const int count = sizeof(matrix_components) / sizeof(matrix_components[0]);
+    for (int i = 0; i < count; i++)
+    {
+        if (matrix_components[i].type == type)
+            return &matrix_components[i];
+    }
+
+    return 0;
+}
+
+// the shader declares the component type only if the device has the matching feature
+static bool support_matrix_component(const ncnn::VulkanDevice* vkdev, const vkpeak_matrix_component* component)
+{
+    switch (component->type)
+    {
+    case VK_COMPONENT_TYPE_FLOAT16_KHR:
+        return vkdev->info.support_fp16_arithmetic();
+    case VK_COMPONENT_TYPE_FLOAT64_KHR:
+        return vkdev->info.physicalDevicefeatures().shaderFloat64;
+    case VK_COMPONENT_TYPE_SINT8_KHR:
+    case VK_COMPONENT_TYPE_UINT8_KHR:
+        return vkdev->info.support_int8_arithmetic();
+    case VK_COMPONENT_TYPE_SINT16_KHR:
+    case VK_COMPONENT_TYPE_UINT16_KHR:
+        return vkdev->info.physicalDevicefeatures().shaderInt16;
+    case VK_COMPONENT_TYPE_SINT64_KHR:
+    case VK_COMPONENT_TYPE_UINT64_KHR:
+        return vkdev->info.physicalDevicefeatures().shaderInt64;
+    case VK_COMPONENT_TYPE_BFLOAT16_KHR:
+        return vkdev->info.queryShaderBfloat16Features().shaderBFloat16CooperativeMatrix;
+    case VK_COMPONENT_TYPE_FLOAT8_E4M3_EXT:
+    case VK_COMPONENT_TYPE_FLOAT8_E5M2_EXT:
+        return vkdev->info.support_VK_EXT_shader_float8() && vkdev->info.queryShaderFloat8Features().shaderFloat8CooperativeMatrix;
+    default:
+        return true;
+    }
+}
+
+// the subgroup scope configurations, from VK_KHR_cooperative_matrix if present else VK_NV_cooperative_matrix
+static void get_matrix_configs(const ncnn::VulkanDevice* vkdev, std::vector<vkpeak_matrix_config>& configs)
+{
+    configs.clear();
+
+    if (!vkdev->info.support_cooperative_matrix())
+        return;
+
+    if (vkdev->info.support_VK_KHR_cooperative_matrix())
+    {
+        const std::vector<VkCooperativeMatrixPropertiesKHR>& properties = vkdev->info.queryCooperativeMatrixProperties();
+
+        for (uint32_t j = 0; j < properties.size(); j++)
+        {
+            const VkCooperativeMatrixPropertiesKHR& cmp = properties[j];
+
+            if (cmp.scope != VK_SCOPE_SUBGROUP_KHR)
+                continue;
+
+            vkpeak_matrix_config config;
+            config.M = cmp.MSize;
+            config.N = cmp.NSize;
+            config.K = cmp.KSize;
+            config.a_type = cmp.AType;
+            config.b_type = cmp.BType;
+            config.c_type = cmp.CType;
+            config.result_type = cmp.ResultType;
+            config.saturating = cmp.saturatingAccumulation ? 1 : 0;
+            configs.push_back(config);
+        }
+    }
+    else // if (vkdev->info.support_VK_NV_cooperative_matrix())
+    {
+        const std::vector<VkCooperativeMatrixPropertiesNV>& properties = vkdev->info.queryCooperativeMatrixPropertiesNV();
+
+        for (uint32_t j = 0; j < properties.size(); j++)
+        {
+            const VkCooperativeMatrixPropertiesNV& cmp = properties[j];
+
+            if (cmp.scope != VK_SCOPE_SUBGROUP_NV)
+                continue;
+
+            vkpeak_matrix_config config;
+            config.M = cmp.MSize;
+            config.N = cmp.NSize;
+            config.K = cmp.KSize;
+            config.a_type = cmp.AType;
+            config.b_type = cmp.BType;
+            config.c_type = cmp.CType;
+            config.result_type = cmp.DType;
+            config.saturating = 0;
+            configs.push_back(config);
+        }
+    }
+}
+
+static std::string matrix_type_glsl(const vkpeak_matrix_component* component, bool khr, const char* rows, const char* cols, const char* use)
+{
+    if (khr)
+        return std::string("coopmat<") + component->glsl_type + ", gl_ScopeSubgroup, " + rows + ", " + cols + ", " + use + ">";
+
+    char bits[16];
+    sprintf(bits, "%d", component->size * 8);
+
+    return std::string(1, component->kind) + "coopmatNV<" + bits + ", gl_ScopeSubgroup, " + rows + ", " + cols + ">";
+}
+
+static std::string build_matrix_glsl(const char* body, const vkpeak_matrix_config& config, bool khr)
+{
+    const vkpeak_matrix_component* a = find_matrix_component(config.a_type);
+    const vkpeak_matrix_component* b = find_matrix_component(config.b_type);
+    const vkpeak_matrix_component* c = find_matrix_component(config.c_type);
+
+    std::string glsl = "#version 450\n";
+
+    glsl += "#extension GL_EXT_shader_explicit_arithmetic_types: require\n";
+    glsl += "#extension GL_KHR_memory_scope_semantics: require\n";
+
+    if (khr)
+    {
+        glsl += "#extension GL_KHR_cooperative_matrix: require\n";
+    }
+    else
+    {
+        glsl += "#extension GL_NV_cooperative_matrix: require\n";
+        if (a->kind != 'f' || c->kind != 'f')
+            glsl += "#extension GL_NV_integer_cooperative_matrix: require\n";
+    }
+
+    if (a->type == VK_COMPONENT_TYPE_BFLOAT16_KHR || b->type == VK_COMPONENT_TYPE_BFLOAT16_KHR || c->type == VK_COMPONENT_TYPE_BFLOAT16_KHR)
+    {
+        glsl += "#extension GL_EXT_bfloat16: require\n";
+    }
+    if (a->type == VK_COMPONENT_TYPE_FLOAT8_E4M3_EXT || b->type == VK_COMPONENT_TYPE_FLOAT8_E4M3_EXT || c->type == VK_COMPONENT_TYPE_FLOAT8_E4M3_EXT)
+    {
+        glsl += "#extension GL_EXT_float_e4m3: require\n";
+    }
+    if (a->type == VK_COMPONENT_TYPE_FLOAT8_E5M2_EXT || b->type == VK_COMPONENT_TYPE_FLOAT8_E5M2_EXT || c->type == VK_COMPONENT_TYPE_FLOAT8_E5M2_EXT)
+    {
+        glsl += "#extension GL_EXT_float_e5m2: require\n";
+    }
+
+    glsl += std::string("#define AT ") + a->glsl_type + "\n";
+    glsl += std::string("#define BT ") + b->glsl_type + "\n";
+    glsl += std::string("#define CT ") + c->glsl_type + "\n";
+
+    char cs[16];
+    sprintf(cs, "%d", c->size);
+    glsl += std::string("#define CS ") + cs + "\n";
+
+    glsl += "#define MAT_A " + matrix_type_glsl(a, khr, "M", "K", "gl_MatrixUseA") + "\n";
+    glsl += "#define MAT_B " + matrix_type_glsl(b, khr, "K", "N", "gl_MatrixUseB") + "\n";
+    glsl += "#define MAT_C " + matrix_type_glsl(c, khr, "M", "N", "gl_MatrixUseAccumulator") + "\n";
+
+    // the signedness of a and b follows from their component types
+    if (khr)
+    {
+        if (config.saturating)
+            glsl += "#define MULADD(a, b, c) coopMatMulAdd(a, b, c, gl_MatrixOperandsSaturatingAccumulation)\n";
+        else
+            glsl += "#define MULADD(a, b, c) coopMatMulAdd(a, b, c)\n";
+
+        glsl += "#define STORE(c, buf, offset, stride) coopMatStore(c, buf, offset, stride, gl_CooperativeMatrixLayoutRowMajor)\n";
+    }
+    else
+    {
+        glsl += "#define MULADD(a, b, c) coopMatMulAddNV(a, b, c)\n";
+        glsl += "#define STORE(c, buf, offset, stride) coopMatStoreNV(c, buf, offset, stride, false)\n";
+    }
+
+    glsl += body;
+
+    return glsl;
+}
+
+int vkpeak_get_matrix_config_count()
+{
+    ncnn::VulkanDevice* vkdev = vkpeak_get_device();
+
+    if (!vkdev)
+    {
+        return 0;
+    }
+
+    std::vector<vkpeak_matrix_config> configs;
+    get_matrix_configs(vkdev, configs);
+
+    return (int)configs.size();
+}
+
+int vkpeak_get_matrix_config(int config_index, vkpeak_matrix_config* config)
+{
+    ncnn::VulkanDevice* vkdev = vkpeak_get_device();
+
+    if (!vkdev)
+    {
+        return -1;
+    }
+
+    std::vector<vkpeak_matrix_config> configs;
+    get_matrix_configs(vkdev, configs);
+
+    if (config_index < 0 || config_index >= (int)configs.size())
+    {
+        return -1;
+    }
+
+    *config = configs[config_index];
+
+    return 0;
+}
+
+const char* vkpeak_matrix_type_name(int component_type)
+{
+    const vkpeak_matrix_component* component = find_matrix_component(component_type);
+
+    return component ? component->name : "?";
+}
+
+// 0 if a kernel can be generated for config and the device has every component type
+static int check_matrix_config(const ncnn::VulkanDevice* vkdev, const vkpeak_matrix_config& config)
+{
+    const vkpeak_matrix_component* a = find_matrix_component(config.a_type);
+    const vkpeak_matrix_component* b = find_matrix_component(config.b_type);
+    const vkpeak_matrix_component* c = find_matrix_component(config.c_type);
+    if (!a || !b || !c)
+    {
+        // unknown component type
+        return -1;
+    }
+
+    // glsl multiply add returns the accumulator type
+    if (config.result_type != config.c_type)
+    {
+        return -1;
+    }
+
+    if (!support_matrix_component(vkdev, a) || !support_matrix_component(vkdev, b) || !support_matrix_component(vkdev, c))
+    {
+        return -1;
+    }
+
+    // a row of c must be whole uints
+    if (config.N * c->size % 4 != 0)
+    {
+        return -1;
+    }
+
+    return 0;
+}
+
+// time the kernels of one configuration, every invocation stores one M x N matrix
+static double run_matrix(ncnn::VulkanDevice* vkdev, const vkpeak_matrix_config& config, const std::vector<vkpeak_kernel>& kernels, int loop, int count_mb, int cmd_loop)
+{
+    const int c_size = find_matrix_component(config.c_type)->size;
+
+    ncnn::Option opt;
+    opt.use_vulkan_compute = true;
+    opt.use_fp16_packed = false;
+    opt.use_fp16_storage = false;
+    opt.use_fp16_arithmetic = false;
+
+    const int subgroup_size = std::max(1, (int)vkdev->info.subgroup_size());
+
+    ncnn::VkAllocator* allocator = vkdev->acquire_blob_allocator();
+
+    int buffer_size = vkpeak_buffer_size(vkdev, count_mb);
+
+    ncnn::VkMat c(buffer_size, (size_t)1u, 1, allocator);
+
+    // matrix on subgroup, every subgroup of the workgroup runs its own matrix
+    int local_size_x = std::max(vkpeak_local_size(vkdev, subgroup_size) / subgroup_size, 1) * subgroup_size;
+
+    int max_invocation_count = std::max(buffer_size / (config.M * config.N * c_size), 1);
+
+    // start with little works
+    int invocation_count = std::max(max_invocation_count / 32, 8);
+
+    std::vector<ncnn::vk_specialization_type> specializations(4);
+    specializations[1].i = config.M;
+    specializations[2].i = config.N;
+    specializations[3].i = config.K;
+
+    vkpeak_workload workload;
+    workload.vkdev = vkdev;
+    workload.opt = opt;
+    workload.kernels = kernels;
+    workload.specializations = specializations;
+    workload.bindings.push_back(c);
+    workload.local_size_x = local_size_x;
+    workload.invocation_count = invocation_count;
+    workload.max_invocation_count = max_invocation_count;
+    workload.split_queues = true;
+
+    double max_gops = vkpeak_run(workload, loop, cmd_loop);
+
+    vkdev->reclaim_blob_allocator(allocator);
+
+    return max_gops;
+}
+
+double vkpeak_matrix(int loop, int count_mb, int cmd_loop, int config_index)
+{
+    ncnn::VulkanDevice* vkdev = vkpeak_get_device();
+
+    if (!vkdev)
+    {
+        return 0;
+    }
+
+    vkpeak_matrix_config config;
+    int ret = vkpeak_get_matrix_config(config_index, &config);
+    if (ret != 0)
+    {
+        return 0;
+    }
+
+    ret = check_matrix_config(vkdev, config);
+    if (ret != 0)
+    {
+        return 0;
+    }
+
+    const bool khr = vkdev->info.support_VK_KHR_cooperative_matrix();
+
+    const int subgroup_size = std::max(1, (int)vkdev->info.subgroup_size());
+
+    // one multiply add is M * N * K fma shared by the subgroup
+    const double scale = (double)(config.M * config.N * config.K) / subgroup_size;
+
+    vkpeak_kernel kernel;
+    kernel.glsl = build_matrix_glsl(glsl_matrix_data, config, khr);
+    kernel.ops_per_loop = 16 * 2 * scale;
+    kernel.ops_tail = 0;
+
+    vkpeak_kernel kernel_dual;
+    kernel_dual.glsl = build_matrix_glsl(glsl_matrix_dual_data, config, khr);
+    kernel_dual.ops_per_loop = 16 * 2 * scale;
+    kernel_dual.ops_tail = 1 * scale; // +1 for the tail c0+c1
+
+    std::vector<vkpeak_kernel> kernels;
+    kernels.push_back(kernel);
+    kernels.push_back(kernel_dual);
+
+    return run_matrix(vkdev, config, kernels, loop, count_mb, cmd_loop);
+}
+
+// rows a fragments and cols b fragments feed a rows x cols grid of accumulators, as in a gemm microkernel
+// the grid is repeated until the loop holds at least 16 multiply adds
+static std::string build_matrix_blocked_body(int rows, int cols)
+{
+    char line[256];
+
+    std::string body;
+
+    body += "layout (constant_id = 0) const int loop = 1;\n";
+    body += "layout (constant_id = 1) const int M = 1;\n";
+    body += "layout (constant_id = 2) const int N = 1;\n";
+    body += "layout (constant_id = 3) const int K = 1;\n";
+    body += "\n";
+    body += "layout (binding = 0) writeonly buffer c_blob { uint c_blob_data[]; };\n";
+    body += "\n";
+    body += "void main()\n";
+    body += "{\n";
+    body += "    const uint gx = gl_GlobalInvocationID.x;\n";
+    body += "    const uint lx = gl_LocalInvocationID.x;\n";
+    body += "\n";
+
+    // distinct fragments so that the compiler cannot merge them
+    for (int r = 0; r < rows; r++)
+    {
+        sprintf(line, "    MAT_A a%d = MAT_A(AT(float((gx + %du) & 7u)));\n", r, r);
+        body += line;
+    }
+    for (int c = 0; c < cols; c++)
+    {
+        sprintf(line, "    MAT_B b%d = MAT_B(BT(float((lx + %du) & 7u)));\n", c, c);
+        body += line;
+    }
+    body += "\n";
+    for (int r = 0; r < rows; r++)
+    {
+        for (int c = 0; c < cols; c++)
+        {
+            sprintf(line, "    MAT_C c%d%d = MAT_C(CT(float((gx + %du) & 7u)));\n", r, c, r * cols + c);
+            body += line;
+        }
+    }
+    body += "\n";
+
+    const int repeat = std::max(16 / (rows * cols), 1);
+
+    body += "    for (int i = 0; i < loop; i++)\n";
+    body += "    {\n";
+    for (int k = 0; k < repeat; k++)
+    {
+        for (int r = 0; r < rows; r++)
+        {
+            for (int c = 0; c < cols; c++)
+            {
+                sprintf(line, "        c%d%d = MULADD(a%d, b%d, c%d%d);\n", r, c, r, c, r, c);
+                body += line;
+            }
+        }
+    }
+    body += "    }\n";
+    body += "\n";
+
+    for (int r = 0; r < rows; r++)
+    {
+        for (int c = 0; c < cols; c++)
+        {
+            if (r == 0 && c == 0)
+                continue;
+
+            sprintf(line, "    c00 = c00 + c%d%d;\n", r, c);
+            body += line;
+        }
+    }
+    body += "    STORE(c00, c_blob_data, gx * (M * N) * CS / 4, N * CS / 4);\n";
+    body += "}\n";
+
+    return body;
+}
+
+double vkpeak_matrix_blocked(int loop, int count_mb, int cmd_loop, int config_index, int rows, int cols)
+{
+    ncnn::VulkanDevice* vkdev = vkpeak_get_device();
+
+    if (!vkdev)
+    {
+        return 0;
+    }
+
+    if (rows < 1 || rows > 4 || cols < 1 || cols > 4)
+    {
+        return 0;
+    }
+
+    vkpeak_matrix_config config;
+    int ret = vkpeak_get_matrix_config(config_index, &config);
+    if (ret != 0)
+    {
+        return 0;
+    }
+
+    ret = check_matrix_config(vkdev, config);
+    if (ret != 0)
+    {
+        return 0;
+    }
+
+    const bool khr = vkdev->info.support_VK_KHR_cooperative_matrix();
+
+    const int subgroup_size = std::max(1, (int)vkdev->info.subgroup_size());
+
+    // one multiply add is M * N * K fma shared by the subgroup
+    const double scale = (double)(config.M * config.N * config.K) / subgroup_size;
+
+    const std::string body = build_matrix_blocked_body(rows, cols);
+
+    vkpeak_kernel kernel;
+    kernel.glsl = build_matrix_glsl(body.c_str(), config, khr);
+    kernel.ops_per_loop = std::max(16 / (rows * cols), 1) * rows * cols * 2 * scale;
+    kernel.ops_tail = (rows * cols - 1) * scale;
+
+    std::vector<vkpeak_kernel> kernels;
+    kernels.push_back(kernel);
+
+    return run_matrix(vkdev, config, kernels, loop, count_mb, cmd_loop);
+}
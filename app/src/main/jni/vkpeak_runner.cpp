@@ -0,0 +1,866 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "vkpeak.h"
+#include "vkpeak_runner.h"
+#include "vkpeak_cache.h"
+
+#include <math.h>
+
+#include <algorithm>
+
+// ncnn
+#include <benchmark.h>
+#include <command.h>
+#include <pipeline.h>
+#include <platform.h>
+
+static int g_timing_type = 0;
+static int g_loop_type = 0;
+static int g_dispatch_count = 1;
+static int g_queue_count = 1;
+static double g_cv_threshold = 0;
+static double g_time_budget = 10000;
+static double g_sustained_duration = 0;
+static int g_local_size = 0;
+
+// per thread, so concurrent runs on several devices do not mix their statistics
+static thread_local vkpeak_stats g_last_stats;
+static thread_local int g_device_index = -1;
+
+// the samples of the last sustained run, a ring buffer that keeps the latest sustained_capacity samples
+// 100ms samples cover the last 27 minutes
+static const int sustained_capacity = 16384;
+
+struct vkpeak_sustained_ring
+{
+    std::vector<double> times;
+    std::vector<double> values;
+
+    // next slot to write and the number of valid samples
+    int head;
+    int count;
+};
+
+static thread_local vkpeak_sustained g_last_sustained;
+static thread_local vkpeak_sustained_ring g_sustained_ring;
+
+void vkpeak_set_device_index(int device_index)
+{
+    g_device_index = device_index;
+}
+
+int vkpeak_get_device_count()
+{
+    return ncnn::get_gpu_count();
+}
+
+ncnn::VulkanDevice* vkpeak_get_device()
+{
+    return ncnn::get_gpu_device(g_device_index == -1 ? ncnn::get_default_gpu_index() : g_device_index);
+}
+
+void vkpeak_set_timing_type(int timing_type)
+{
+    g_timing_type = timing_type;
+}
+
+void vkpeak_set_loop_type(int loop_type)
+{
+    g_loop_type = loop_type;
+}
+
+void vkpeak_set_dispatch_count(int dispatch_count)
+{
+    g_dispatch_count = std::max(dispatch_count, 1);
+}
+
+void vkpeak_set_queue_count(int queue_count)
+{
+    g_queue_count = std::max(queue_count, 1);
+}
+
+void vkpeak_set_sampler(double cv_threshold, int time_budget_ms)
+{
+    g_cv_threshold = cv_threshold;
+    g_time_budget = time_budget_ms;
+}
+
+void vkpeak_set_local_size(int local_size_x)
+{
+    g_local_size = std::max(local_size_x, 0);
+}
+
+int vkpeak_local_size(const ncnn::VulkanDevice* vkdev, int default_local_size)
+{
+    if (g_local_size == 0)
+        return default_local_size;
+
+    int local_size_x = std::min(g_local_size, (int)vkdev->info.max_workgroup_size_x());
+    local_size_x = std::min(local_size_x, (int)vkdev->info.max_workgroup_invocations());
+
+    return local_size_x;
+}
+
+void vkpeak_get_last_stats(vkpeak_stats* stats)
+{
+    *stats = g_last_stats;
+}
+
+void vkpeak_set_sustained(int duration_ms)
+{
+    g_sustained_duration = std::max(duration_ms, 0);
+}
+
+void vkpeak_get_sustained(vkpeak_sustained* sustained)
+{
+    *sustained = g_last_sustained;
+}
+
+int vkpeak_get_sustained_samples(double* times_ms, double* values, int max_count)
+{
+    const vkpeak_sustained_ring& ring = g_sustained_ring;
+
+    const int count = std::min(ring.count, max_count);
+
+    // oldest first
+    const int capacity = (int)ring.times.size();
+    const int first = (ring.head - ring.count + capacity) % std::max(capacity, 1);
+
+    for (int i = 0; i < count; i++)
+    {
+        const int j = (first + i) % capacity;
+        times_ms[i] = ring.times[j];
+        values[i] = ring.values[j];
+    }
+
+    return count;
+}
+
+// the number of meaningful low bits of a timestamp written on the compute queue, 0 for none
+static uint32_t timestamp_valid_bits(const ncnn::VulkanDevice* vkdev)
+{
+    const uint32_t queue_family_index = vkdev->info.compute_queue_family_index();
+
+    uint32_t queue_family_count = 0;
+    vkGetPhysicalDeviceQueueFamilyProperties(vkdev->info.physicalDevice(), &queue_family_count, 0);
+
+    std::vector<VkQueueFamilyProperties> queue_family_properties(queue_family_count);
+    vkGetPhysicalDeviceQueueFamilyProperties(vkdev->info.physicalDevice(), &queue_family_count, queue_family_properties.data());
+
+    if (queue_family_index >= queue_family_count)
+        return 0;
+
+    return queue_family_properties[queue_family_index].timestampValidBits;
+}
+
+bool vkpeak_support_timestamp(const ncnn::VulkanDevice* vkdev)
+{
+#if NCNN_BENCHMARK
+    return vkdev->info.physicalDeviceProperties().limits.timestampComputeAndGraphics && vkdev->info.timestamp_period() > 0.f && timestamp_valid_bits(vkdev) > 0;
+#else
+    (void)vkdev;
+    return false;
+#endif
+}
+
+int vkpeak_buffer_size(const ncnn::VulkanDevice* vkdev, int count_mb)
+{
+    // reuse c storage, max 512M
+    int buffer_size = std::min((int)(vkdev->get_heap_budget() / 8), 512) * 1024 * 1024;
+    if (vkdev->info.type() == 1)
+    {
+        // max 128M for integrated gpu
+        buffer_size = std::min(buffer_size, 128 * 1024 * 1024);
+    }
+
+    buffer_size = std::min(buffer_size, count_mb * 1024 * 1024);
+
+    return buffer_size;
+}
+
+static void destroy_pipelines(std::vector<ncnn::Pipeline*>& pipelines)
+{
+    for (size_t i = 0; i < pipelines.size(); i++)
+    {
+        delete pipelines[i];
+    }
+    pipelines.clear();
+}
+
+// turn the loop specialization constant into a push constant, the compiler can no longer
+// unroll or strength reduce the loop and one pipeline serves every loop count
+// constant_id 0 stays declared and is specialized to 1 so the specialization layout is unchanged
+static bool make_push_constant_loop(std::string& glsl)
+{
+    static const char loop_spec[] = "layout (constant_id = 0) const int loop = 1;";
+
+    size_t pos = glsl.find(loop_spec);
+    if (pos == std::string::npos)
+        return false;
+
+    glsl.replace(pos, sizeof(loop_spec) - 1,
+                 "layout (constant_id = 0) const int loop_spec = 1;\n"
+                 "layout (push_constant) uniform parameter { int loop_pc; } p;\n"
+                 "#define loop (p.loop_pc * loop_spec)");
+
+    return true;
+}
+
+static int create_pipelines(const vkpeak_workload& workload, bool push_constant_loop, int loop, std::vector<ncnn::Pipeline*>& pipelines)
+{
+    ncnn::VulkanDevice* vkdev = workload.vkdev;
+
+    const size_t kernel_count = workload.kernels.size();
+
+    std::vector<ncnn::vk_specialization_type> specializations = workload.specializations;
+    specializations[0].i = push_constant_loop ? 1 : loop;
+
+    pipelines.resize(kernel_count);
+    for (size_t k = 0; k < kernel_count; k++)
+    {
+        pipelines[k] = new ncnn::Pipeline(vkdev);
+        pipelines[k]->set_local_size_xyz(workload.local_size_x, 1, 1);
+
+        std::string glsl = workload.kernels[k].glsl;
+        if (push_constant_loop)
+        {
+            make_push_constant_loop(glsl);
+        }
+
+        // glsl to spirv
+        std::vector<uint32_t> spirv;
+        int ret = vkpeak_compile_spirv(vkdev, glsl, workload.opt, spirv);
+        if (ret == 0)
+        {
+            ret = pipelines[k]->create(spirv.data(), spirv.size() * 4, specializations);
+        }
+        if (ret != 0)
+        {
+            destroy_pipelines(pipelines);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+// every kernel must carry the loop specialization constant to run with a push constant loop
+static bool use_push_constant_loop(const vkpeak_workload& workload)
+{
+    if (g_loop_type != 1)
+        return false;
+
+    for (size_t k = 0; k < workload.kernels.size(); k++)
+    {
+        std::string glsl = workload.kernels[k].glsl;
+        if (!make_push_constant_loop(glsl))
+            return false;
+    }
+
+    return true;
+}
+
+int vkpeak_prepare(vkpeak_workload& workload, int loop)
+{
+    const bool push_constant_loop = use_push_constant_loop(workload);
+
+    int ret = create_pipelines(workload, push_constant_loop, loop, workload.pipelines);
+    if (ret != 0)
+        return -1;
+
+    // the same key measure() checks
+    workload.pipeline_loop = push_constant_loop ? 1 : loop;
+
+    return 0;
+}
+
+static void destroy_commands(std::vector<ncnn::VkCompute*>& cmds)
+{
+    for (size_t i = 0; i < cmds.size(); i++)
+    {
+        delete cmds[i];
+    }
+    cmds.clear();
+}
+
+// the state one vkpeak_run call keeps across measurements
+struct vkpeak_run_state
+{
+    const vkpeak_workload* workload;
+
+    bool use_timestamp;
+    uint64_t timestamp_mask;
+    bool push_constant_loop;
+    int dispatch_count;
+    int queue_count;
+
+    std::vector<ncnn::Pipeline*> pipelines;
+
+    // loop count the pipelines are specialized for, -1 for none
+    int pipeline_loop;
+};
+
+// invocations of each of the queue_count dispatches, a multiple of local_size_x
+static int queue_invocation_count(const vkpeak_run_state& st, int invocation_count)
+{
+    if (st.queue_count == 1)
+        return invocation_count;
+
+    const int local_size_x = st.workload->local_size_x;
+
+    return std::max(invocation_count / st.queue_count / local_size_x, 1) * local_size_x;
+}
+
+struct vkpeak_submit_task
+{
+    ncnn::VkCompute* cmd;
+
+    int ret;
+    double t0;
+    double t1;
+};
+
+static void* submit_worker(void* args)
+{
+    vkpeak_submit_task* task = (vkpeak_submit_task*)args;
+
+    task->t0 = ncnn::get_current_time();
+    task->ret = task->cmd->submit_and_wait();
+    task->t1 = ncnn::get_current_time();
+
+    return 0;
+}
+
+// one submit per kernel, split over queue_count queues, times in milliseconds
+static int measure(vkpeak_run_state& st, int invocation_count, int loop, std::vector<double>& times)
+{
+    const vkpeak_workload& workload = *st.workload;
+
+    ncnn::VulkanDevice* vkdev = workload.vkdev;
+
+    const size_t kernel_count = workload.kernels.size();
+
+    // setup pipeline, once per loop count for the specialization constant loop
+    const int pipeline_loop = st.push_constant_loop ? 1 : loop;
+    if (st.pipeline_loop != pipeline_loop)
+    {
+        destroy_pipelines(st.pipelines);
+        st.pipeline_loop = -1;
+
+        int ret = create_pipelines(workload, st.push_constant_loop, loop, st.pipelines);
+        if (ret != 0)
+            return -1;
+
+        st.pipeline_loop = pipeline_loop;
+    }
+
+    const int queue_count = st.queue_count;
+
+    // encode command, one command buffer per kernel and queue
+    std::vector<ncnn::VkCompute*> cmds(kernel_count * queue_count);
+    {
+        std::vector<ncnn::vk_constant_type> constants(st.push_constant_loop ? 1 : 0);
+        if (st.push_constant_loop)
+        {
+            constants[0].i = loop;
+        }
+
+        ncnn::VkMat dispatcher;
+        dispatcher.w = queue_invocation_count(st, invocation_count);
+        dispatcher.h = 1;
+        dispatcher.c = 1;
+
+        for (size_t i = 0; i < cmds.size(); i++)
+        {
+            const size_t k = i / queue_count;
+
+            cmds[i] = new ncnn::VkCompute(vkdev);
+
+#if NCNN_BENCHMARK
+            if (st.use_timestamp)
+            {
+                cmds[i]->create_query_pool(2);
+                cmds[i]->record_write_timestamp(0);
+            }
+#endif
+
+            // back to back dispatches in one submit amortize the submit and fence wait cost
+            for (int j = 0; j < st.dispatch_count; j++)
+            {
+                cmds[i]->record_pipeline(st.pipelines[k], workload.bindings, constants, dispatcher);
+            }
+
+#if NCNN_BENCHMARK
+            if (st.use_timestamp)
+            {
+                cmds[i]->record_write_timestamp(1);
+            }
+#endif
+        }
+    }
+
+    // time this
+    times.resize(kernel_count);
+    for (size_t k = 0; k < kernel_count; k++)
+    {
+        std::vector<vkpeak_submit_task> tasks(queue_count);
+        for (int q = 0; q < queue_count; q++)
+        {
+            tasks[q].cmd = cmds[k * queue_count + q];
+        }
+
+        if (queue_count == 1)
+        {
+            submit_worker(&tasks[0]);
+        }
+        else
+        {
+            // every thread holds one of the device compute queues while it waits
+            std::vector<ncnn::Thread*> threads(queue_count);
+            for (int q = 0; q < queue_count; q++)
+            {
+                threads[q] = new ncnn::Thread(submit_worker, &tasks[q]);
+            }
+            for (int q = 0; q < queue_count; q++)
+            {
+                threads[q]->join();
+                delete threads[q];
+            }
+        }
+
+        double t0 = tasks[0].t0;
+        double t1 = tasks[0].t1;
+        for (int q = 0; q < queue_count; q++)
+        {
+            if (tasks[q].ret != 0)
+            {
+                destroy_commands(cmds);
+                return -1;
+            }
+
+            t0 = std::min(t0, tasks[q].t0);
+            t1 = std::max(t1, tasks[q].t1);
+        }
+
+        times[k] = t1 - t0;
+
+#if NCNN_BENCHMARK
+        // timestamps of different queues are not guaranteed to share a time base, keep the host span for several queues
+        if (st.use_timestamp && queue_count == 1)
+        {
+            std::vector<uint64_t> results(2);
+            int ret = tasks[0].cmd->get_query_pool_results(0, 2, results);
+
+            // only the low timestampValidBits are defined, the difference modulo that width survives a counter wrap
+            const uint64_t ticks = ((results[1] & st.timestamp_mask) - (results[0] & st.timestamp_mask)) & st.timestamp_mask;
+
+            // keep the host time if the query failed
+            if (ret == 0 && ticks > 0)
+            {
+                times[k] = ticks * (double)vkdev->info.timestamp_period() / 1000000;
+            }
+        }
+#endif
+    }
+
+    destroy_commands(cmds);
+
+    return 0;
+}
+
+// the best kernel of one measurement in ops per nanosecond, its index in best_kernel if not null
+static double best_gops(const vkpeak_run_state& st, int invocation_count, int loop, const std::vector<double>& times, int* best_kernel = 0)
+{
+    const vkpeak_workload& workload = *st.workload;
+
+    const double total_invocation_count = (double)queue_invocation_count(st, invocation_count) * st.queue_count;
+
+    double max_gops = 0;
+    for (size_t k = 0; k < workload.kernels.size(); k++)
+    {
+        const vkpeak_kernel& kernel = workload.kernels[k];
+
+        double ops = (double)st.dispatch_count * total_invocation_count * ((double)loop * kernel.ops_per_loop + kernel.ops_tail);
+
+        double gops = ops / times[k] / 1000000;
+
+        // fprintf(stderr, "%f gops\n", gops);
+
+        if (gops > max_gops)
+        {
+            max_gops = gops;
+            if (best_kernel)
+                *best_kernel = (int)k;
+        }
+    }
+
+    return max_gops;
+}
+
+// double invocation_count until max_invocation_count, then double loop
+// return 1 if invocation_count grew and 2 if loop grew
+static int grow_work(const vkpeak_workload& workload, int& invocation_count, int& loop)
+{
+    // for fast device
+    if (invocation_count * 2 <= workload.max_invocation_count)
+    {
+        invocation_count = std::min(invocation_count * 2, workload.max_invocation_count);
+        return 1;
+    }
+
+    loop *= 2;
+    return 2;
+}
+
+// linear interpolation between the closest ranks of sorted samples
+static double percentile(const std::vector<double>& sorted, double p)
+{
+    const double pos = p * (sorted.size() - 1);
+    const size_t i = (size_t)pos;
+    if (i + 1 >= sorted.size())
+        return sorted.back();
+
+    return sorted[i] + (sorted[i + 1] - sorted[i]) * (pos - i);
+}
+
+static void compute_stats(std::vector<double> samples, vkpeak_stats& stats)
+{
+    stats = vkpeak_stats();
+
+    const size_t n = samples.size();
+    if (n == 0)
+        return;
+
+    std::sort(samples.begin(), samples.end());
+
+    stats.median = percentile(samples, 0.5);
+    stats.p10 = percentile(samples, 0.1);
+    stats.p90 = percentile(samples, 0.9);
+    stats.max = samples.back();
+    stats.sample_count = (int)n;
+
+    double sum = 0;
+    for (size_t i = 0; i < n; i++)
+    {
+        sum += samples[i];
+    }
+    const double mean = sum / n;
+
+    if (n > 1 && mean > 0)
+    {
+        double sqsum = 0;
+        for (size_t i = 0; i < n; i++)
+        {
+            sqsum += (samples[i] - mean) * (samples[i] - mean);
+        }
+
+        // coefficient of variation of the mean estimate, the standard error over the mean
+        stats.cv = sqrt(sqsum / (n - 1) / n) / mean;
+    }
+}
+
+// the original scheme, grow the work until every submit takes min_time and keep cmd_loop samples
+static int run_fixed(vkpeak_run_state& st, int invocation_count, int loop, int cmd_loop, std::vector<double>& samples)
+{
+    const double min_time = st.use_timestamp ? 100 : 800;
+
+    std::vector<double> times;
+
+    int i = 0;
+    while (i < cmd_loop)
+    {
+        int ret = measure(st, invocation_count, loop, times);
+        if (ret != 0)
+            return -1;
+
+        if (*std::min_element(times.begin(), times.end()) < min_time)
+        {
+            // the samples of the smaller work are below min_time, start over
+            grow_work(*st.workload, invocation_count, loop);
+            samples.clear();
+            i = 0;
+            continue;
+        }
+
+        samples.push_back(best_gops(st, invocation_count, loop, times));
+        i++;
+    }
+
+    return 0;
+}
+
+// grow the work geometrically to the target time and bisect the last step back towards it
+static int calibrate(vkpeak_run_state& st, double target_time, int& invocation_count, int& loop)
+{
+    const vkpeak_workload& workload = *st.workload;
+
+    std::vector<double> times;
+
+    // geometric search
+    int grown = 0;
+    for (;;)
+    {
+        int ret = measure(st, invocation_count, loop, times);
+        if (ret != 0)
+            return -1;
+
+        if (*std::min_element(times.begin(), times.end()) >= target_time)
+            break;
+
+        grown = grow_work(workload, invocation_count, loop);
+    }
+
+    // bisection between the last too short size and the first long enough size
+    if (grown != 0)
+    {
+        const int align = grown == 1 ? workload.local_size_x : 1;
+
+        int& value = grown == 1 ? invocation_count : loop;
+
+        int lo = value / 2;
+        int hi = value;
+        for (int step = 0; step < 3; step++)
+        {
+            int mid = (lo + hi) / 2 / align * align;
+            if (mid <= lo || mid >= hi)
+                break;
+
+            value = mid;
+
+            int ret = measure(st, invocation_count, loop, times);
+            if (ret != 0)
+                return -1;
+
+            if (*std::min_element(times.begin(), times.end()) >= target_time)
+                hi = mid;
+            else
+                lo = mid;
+        }
+
+        value = hi;
+    }
+
+    return 0;
+}
+
+// calibrate, then sample until the estimate converges or the time budget runs out
+static int run_adaptive(vkpeak_run_state& st, int invocation_count, int loop, int cmd_loop, std::vector<double>& samples)
+{
+    // short submits are fine once the work size is calibrated, the sample count carries the precision
+    const double target_time = st.use_timestamp ? 20 : 200;
+
+    const double t_start = ncnn::get_current_time();
+
+    int ret = calibrate(st, target_time, invocation_count, loop);
+    if (ret != 0)
+        return -1;
+
+    std::vector<double> times;
+
+    // sample
+    const int min_samples = std::max(cmd_loop, 5);
+    const int max_samples = 1000;
+
+    while ((int)samples.size() < max_samples)
+    {
+        ret = measure(st, invocation_count, loop, times);
+        if (ret != 0)
+            return -1;
+
+        samples.push_back(best_gops(st, invocation_count, loop, times));
+
+        if ((int)samples.size() < min_samples)
+            continue;
+
+        vkpeak_stats stats;
+        compute_stats(samples, stats);
+        if (stats.cv < g_cv_threshold)
+            break;
+
+        if (ncnn::get_current_time() - t_start > g_time_budget)
+            break;
+    }
+
+    return 0;
+}
+
+// median of the last few samples, a single slow submit is not a throttle
+static double smoothed(const std::vector<double>& window)
+{
+    std::vector<double> sorted = window;
+    std::sort(sorted.begin(), sorted.end());
+    return percentile(sorted, 0.5);
+}
+
+// calibrate, then keep submitting the fastest kernel for g_sustained_duration and record the throughput over time
+// the ring buffer ends up in samples oldest first, the throttle analysis in g_last_sustained
+static int run_sustained(vkpeak_run_state& st, int invocation_count, int loop, std::vector<double>& samples)
+{
+    // long enough to leave the gpu almost no idle time between submits
+    const double target_time = st.use_timestamp ? 100 : 200;
+
+    // throttled once the smoothed throughput falls below this fraction of the peak so far
+    const double throttle_ratio = 0.9;
+    const int window_size = 5;
+
+    int ret = calibrate(st, target_time, invocation_count, loop);
+    if (ret != 0)
+        return -1;
+
+    // pick the fastest kernel once, the time series must come from one shader
+    std::vector<double> times;
+    ret = measure(st, invocation_count, loop, times);
+    if (ret != 0)
+        return -1;
+
+    int best_kernel = 0;
+    best_gops(st, invocation_count, loop, times, &best_kernel);
+
+    vkpeak_workload workload = *st.workload;
+    workload.kernels.assign(1, st.workload->kernels[best_kernel]);
+    workload.pipelines.clear();
+
+    destroy_pipelines(st.pipelines);
+    st.workload = &workload;
+    st.pipeline_loop = -1;
+
+    vkpeak_sustained_ring& ring = g_sustained_ring;
+    ring.times.assign(sustained_capacity, 0);
+    ring.values.assign(sustained_capacity, 0);
+    ring.head = 0;
+    ring.count = 0;
+
+    vkpeak_sustained& result = g_last_sustained;
+    result.throttle_ms = -1;
+
+    std::vector<double> window;
+
+    const double t_start = ncnn::get_current_time();
+
+    double elapsed = 0;
+    while (elapsed < g_sustained_duration)
+    {
+        // a failed submit ends the run early, the samples so far are still valid
+        ret = measure(st, invocation_count, loop, times);
+        if (ret != 0)
+            break;
+
+        const double gops = best_gops(st, invocation_count, loop, times);
+
+        elapsed = ncnn::get_current_time() - t_start;
+
+        ring.times[ring.head] = elapsed;
+        ring.values[ring.head] = gops;
+        ring.head = (ring.head + 1) % sustained_capacity;
+        ring.count = std::min(ring.count + 1, sustained_capacity);
+        result.sample_count++;
+
+        // the oldest samples may be overwritten, so track the peak and the onset as they come
+        window.push_back(gops);
+        if ((int)window.size() > window_size)
+            window.erase(window.begin());
+
+        if ((int)window.size() < window_size)
+            continue;
+
+        const double value = smoothed(window);
+        if (value > result.peak)
+            result.peak = value;
+
+        if (result.throttle_ms < 0 && value < result.peak * throttle_ratio)
+            result.throttle_ms = elapsed;
+    }
+
+    // the pipelines belong to the local workload
+    destroy_pipelines(st.pipelines);
+
+    if (ring.count == 0)
+        return -1;
+
+    samples.resize(ring.count);
+    std::vector<double> ring_times(ring.count);
+    vkpeak_get_sustained_samples(ring_times.data(), samples.data(), ring.count);
+
+    // the steady state is the median of the last quarter
+    std::vector<double> tail;
+    for (int i = 0; i < ring.count; i++)
+    {
+        if (ring_times[i] >= elapsed * 0.75)
+            tail.push_back(samples[i]);
+    }
+
+    result.steady = smoothed(tail);
+
+    // too short for a smoothed peak
+    if (result.peak == 0)
+        result.peak = *std::max_element(samples.begin(), samples.end());
+
+    result.steady_ratio = result.peak > 0 ? result.steady / result.peak : 0;
+
+    return 0;
+}
+
+double vkpeak_run(const vkpeak_workload& workload, int loop, int cmd_loop)
+{
+    g_last_stats = vkpeak_stats();
+    g_last_sustained = vkpeak_sustained();
+
+    vkpeak_run_state st;
+    st.workload = &workload;
+
+    // device side timestamps exclude submit and fence wait latency, so much shorter runs are stable
+    st.use_timestamp = g_timing_type == 0 && vkpeak_support_timestamp(workload.vkdev);
+    st.timestamp_mask = 0;
+    if (st.use_timestamp)
+    {
+        const uint32_t valid_bits = timestamp_valid_bits(workload.vkdev);
+        st.timestamp_mask = valid_bits >= 64 ? ~0ull : (1ull << valid_bits) - 1;
+    }
+
+    st.push_constant_loop = use_push_constant_loop(workload);
+
+    st.dispatch_count = g_dispatch_count;
+    st.queue_count = workload.split_queues ? std::max(std::min(g_queue_count, (int)workload.vkdev->info.compute_queue_count()), 1) : 1;
+    st.pipeline_loop = -1;
+
+    // pipelines from vkpeak_prepare
+    if (!workload.pipelines.empty())
+    {
+        st.pipelines = workload.pipelines;
+        st.pipeline_loop = workload.pipeline_loop;
+    }
+
+    std::vector<double> samples;
+
+    int ret;
+    if (g_sustained_duration > 0)
+        ret = run_sustained(st, workload.invocation_count, loop, samples);
+    else if (g_cv_threshold > 0)
+        ret = run_adaptive(st, workload.invocation_count, loop, cmd_loop, samples);
+    else
+        ret = run_fixed(st, workload.invocation_count, loop, cmd_loop, samples);
+
+    destroy_pipelines(st.pipelines);
+
+    if (ret != 0)
+        return 0;
+
+    compute_stats(samples, g_last_stats);
+
+    if (g_sustained_duration > 0)
+        return g_last_sustained.steady;
+
+    return g_cv_threshold > 0 ? g_last_stats.median : g_last_stats.max;
+}
@@ -0,0 +1,89 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#ifndef VKPEAK_RUNNER_H
+#define VKPEAK_RUNNER_H
+
+#include <string>
+#include <vector>
+
+// ncnn
+#include <gpu.h>
+#include <mat.h>
+#include <option.h>
+#include <pipeline.h>
+
+// one benchmark shader and the work one invocation of it does
+// ops = invocation_count * (loop * ops_per_loop + ops_tail)
+struct vkpeak_kernel
+{
+    std::string glsl;
+
+    double ops_per_loop;
+    double ops_tail;
+};
+
+// everything the auto-scaling loop needs to dispatch a set of kernels
+// the kernels are timed one by one on the same bindings, the fastest one wins
+struct vkpeak_workload
+{
+    ncnn::VulkanDevice* vkdev;
+    ncnn::Option opt;
+
+    std::vector<vkpeak_kernel> kernels;
+
+    // specializations[0] is the loop count and is overwritten by the runner
+    std::vector<ncnn::vk_specialization_type> specializations;
+
+    std::vector<ncnn::VkMat> bindings;
+
+    int local_size_x;
+
+    // start with invocation_count, double it until max_invocation_count, then double loop
+    int invocation_count;
+    int max_invocation_count;
+
+    // the dispatch may be split over several compute queues, only for alu workloads
+    // every queue dispatch starts at workgroup 0, so memory workloads would hit each other in the caches
+    bool split_queues;
+
+    // pipelines created ahead by vkpeak_prepare for pipeline_loop, vkpeak_run takes them over and destroys them
+    std::vector<ncnn::Pipeline*> pipelines;
+    int pipeline_loop;
+};
+
+// work buffer size in bytes, max 512M and 128M for integrated gpu, capped by count_mb
+int vkpeak_buffer_size(const ncnn::VulkanDevice* vkdev, int count_mb);
+
+// the device selected with vkpeak_set_device_index on the calling thread, null if out of range
+ncnn::VulkanDevice* vkpeak_get_device();
+
+// the workgroup size set with vkpeak_set_local_size capped by the device limits, default_local_size if none
+int vkpeak_local_size(const ncnn::VulkanDevice* vkdev, int default_local_size);
+
+// true if dispatches can be timed with gpu timestamps on the compute queue
+bool vkpeak_support_timestamp(const ncnn::VulkanDevice* vkdev);
+
+// compile the kernels and create the pipelines the first measurement of vkpeak_run with loop needs
+// safe to call for different workloads from several threads, return 0 on success
+int vkpeak_prepare(vkpeak_workload& workload, int loop);
+
+// run the kernels until every submit takes at least 100ms by gpu timestamp,
+// or 800ms by host wall clock when timestamps are unavailable, and repeat cmd_loop times
+// with the sampler enabled, calibrate to a shorter submit and sample until the estimate converges
+// return the best ops per nanosecond (GFLOPS / GIOPS / GB/s), the median with the sampler, 0 for error
+// the statistics of the samples are kept for vkpeak_get_last_stats
+double vkpeak_run(const vkpeak_workload& workload, int loop, int cmd_loop);
+
+#endif // VKPEAK_RUNNER_H
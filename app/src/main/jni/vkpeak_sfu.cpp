@@ -0,0 +1,213 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "vkpeak.h"
+#include "vkpeak_runner.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+// ncnn
+#include <gpu.h>
+#include <mat.h>
+
+// the sfu kernels share one body, T is afp or afpvec4 and OP is one transcendental on c
+// every OP maps a value in [1, 3) back into a small positive range, so the chains never
+// run into inf nan or huge sin arguments that take a slow path on some drivers
+static const char glsl_sfu_data[] = R"(
+layout (constant_id = 0) const int loop = 1;
+
+layout (binding = 0) writeonly buffer c_blob { float c_blob_data[]; };
+
+void main()
+{
+    const uint gx = gl_GlobalInvocationID.x;
+
+    T c = T(afp(float(gx & 15) * 0.125 + 1.0));
+
+    const T b = T(afp(2.0));
+
+    for (int i = 0; i < loop; i++)
+    {
+        c = OP(c);
+        c = OP(c);
+        c = OP(c);
+        c = OP(c);
+        c = OP(c);
+        c = OP(c);
+        c = OP(c);
+        c = OP(c);
+        c = OP(c);
+        c = OP(c);
+        c = OP(c);
+        c = OP(c);
+        c = OP(c);
+        c = OP(c);
+        c = OP(c);
+        c = OP(c);
+    }
+
+    c_blob_data[gx] = TO_FLOAT(c);
+}
+)";
+
+static const char glsl_sfu_dual_data[] = R"(
+layout (constant_id = 0) const int loop = 1;
+
+layout (binding = 0) writeonly buffer c_blob { float c_blob_data[]; };
+
+void main()
+{
+    const uint gx = gl_GlobalInvocationID.x;
+    const uint lx = gl_LocalInvocationID.x;
+
+    T c0 = T(afp(float(gx & 15) * 0.125 + 1.0));
+    T c1 = T(afp(float(lx & 15) * 0.125 + 1.0));
+
+    const T b = T(afp(2.0));
+
+    for (int i = 0; i < loop; i++)
+    {
+        c0 = OP(c0);
+        c1 = OP(c1);
+        c0 = OP(c0);
+        c1 = OP(c1);
+        c0 = OP(c0);
+        c1 = OP(c1);
+        c0 = OP(c0);
+        c1 = OP(c1);
+        c0 = OP(c0);
+        c1 = OP(c1);
+        c0 = OP(c0);
+        c1 = OP(c1);
+        c0 = OP(c0);
+        c1 = OP(c1);
+        c0 = OP(c0);
+        c1 = OP(c1);
+    }
+
+    c_blob_data[gx] = TO_FLOAT(c0) + TO_FLOAT(c1);
+}
+)";
+
+// exp(-x) stays in (0, 1], log(x) + 2 converges to 3.146, sin(x) stays in [-1, 1],
+// inversesqrt(x) converges to 1 and 2 / x oscillates around sqrt(2)
+static const char* const sfu_op_defines[5] = {
+    "exp(-x)",
+    "(log(x) + b)",
+    "sin(x)",
+    "inversesqrt(x)",
+    "(b / x)",
+};
+
+static std::string build_sfu_glsl(const char* body, int packing_type, int func_type)
+{
+    std::string glsl = "#version 450\n";
+
+    if (packing_type == 4)
+    {
+        glsl += "#define T afpvec4\n";
+        glsl += "#define TO_FLOAT(x) dot(vec4(x), vec4(1.0))\n";
+    }
+    else // if (packing_type == 1)
+    {
+        glsl += "#define T afp\n";
+        glsl += "#define TO_FLOAT(x) float(x)\n";
+    }
+
+    glsl += std::string("#define OP(x) ") + sfu_op_defines[func_type] + "\n";
+
+    glsl += body;
+
+    return glsl;
+}
+
+double vkpeak_sfu(int loop, int count_mb, int cmd_loop, int arithmetic_type, int packing_type, int func_type)
+{
+    ncnn::VulkanDevice* vkdev = vkpeak_get_device();
+
+    if (!vkdev)
+    {
+        return 0;
+    }
+
+    if (arithmetic_type != 0 && arithmetic_type != 1)
+    {
+        return 0;
+    }
+    if (packing_type != 1 && packing_type != 4)
+    {
+        return 0;
+    }
+    if (func_type < 0 || func_type > 4)
+    {
+        return 0;
+    }
+
+    if (!vkdev->info.support_fp16_arithmetic() && arithmetic_type == 1)
+    {
+        return 0;
+    }
+
+    ncnn::Option opt;
+    opt.use_vulkan_compute = true;
+    opt.use_fp16_packed = false;
+    opt.use_fp16_storage = false;
+    opt.use_fp16_arithmetic = arithmetic_type == 1;
+
+    // one function per statement, 16 statements per loop
+    vkpeak_kernel kernel;
+    kernel.glsl = build_sfu_glsl(glsl_sfu_data, packing_type, func_type);
+    kernel.ops_per_loop = 16 * packing_type;
+    kernel.ops_tail = 0;
+
+    vkpeak_kernel kernel_dual;
+    kernel_dual.glsl = build_sfu_glsl(glsl_sfu_dual_data, packing_type, func_type);
+    kernel_dual.ops_per_loop = 16 * packing_type;
+    kernel_dual.ops_tail = 0;
+
+    ncnn::VkAllocator* allocator = vkdev->acquire_blob_allocator();
+
+    int buffer_size = vkpeak_buffer_size(vkdev, count_mb);
+
+    ncnn::VkMat c(buffer_size, (size_t)1u, 1, allocator);
+
+    int local_size_x = vkpeak_local_size(vkdev, std::min(128, std::max(1, (int)vkdev->info.subgroup_size())));
+
+    int max_invocation_count = buffer_size / 4;
+    // make max_invocation_count be multiple of local_size_x
+    max_invocation_count = std::max(max_invocation_count / local_size_x, 1) * local_size_x;
+
+    // start with little works
+    int invocation_count = std::max(max_invocation_count / 32 / local_size_x, 1) * local_size_x;
+
+    vkpeak_workload workload;
+    workload.vkdev = vkdev;
+    workload.opt = opt;
+    workload.kernels.push_back(kernel);
+    workload.kernels.push_back(kernel_dual);
+    workload.specializations.resize(1);
+    workload.bindings.push_back(c);
+    workload.local_size_x = local_size_x;
+    workload.invocation_count = invocation_count;
+    workload.max_invocation_count = max_invocation_count;
+    workload.split_queues = true;
+
+    double max_gops = vkpeak_run(workload, loop, cmd_loop);
+
+    vkdev->reclaim_blob_allocator(allocator);
+
+    return max_gops;
+}
@@ -0,0 +1,188 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "vkpeak.h"
+#include "vkpeak_runner.h"
+
+#include <algorithm>
+#include <vector>
+
+// ncnn
+#include <gpu.h>
+#include <mat.h>
+
+// 16KB shared memory, the minimum every vulkan device guarantees
+// invocation lx touches element (lx + k * local_size) * stride, so neighbouring invocations
+// are stride elements apart and hit the same bank when stride shares a factor with the bank count
+
+static const char glsl_shared_load_data[] = R"(
+#version 450
+
+layout (constant_id = 0) const int loop = 1;
+layout (constant_id = 1) const int stride = 1;
+
+layout (binding = 0) writeonly buffer c_blob { float c_blob_data[]; };
+
+shared float tmp[4096];
+
+void main()
+{
+    const uint gx = gl_GlobalInvocationID.x;
+    const uint lx = gl_LocalInvocationID.x;
+    const uint step = gl_WorkGroupSize.x * uint(stride);
+
+    for (uint i = lx; i < 4096; i += gl_WorkGroupSize.x)
+    {
+        tmp[i] = float(gx + i);
+    }
+
+    barrier();
+
+    float c0 = 0.f;
+    float c1 = 0.f;
+
+    uint i0 = lx * uint(stride);
+
+    for (int i = 0; i < loop; i++)
+    {
+        c0 += tmp[i0 & 4095];
+        c1 += tmp[(i0 + step) & 4095];
+        c0 += tmp[(i0 + step * 2) & 4095];
+        c1 += tmp[(i0 + step * 3) & 4095];
+        c0 += tmp[(i0 + step * 4) & 4095];
+        c1 += tmp[(i0 + step * 5) & 4095];
+        c0 += tmp[(i0 + step * 6) & 4095];
+        c1 += tmp[(i0 + step * 7) & 4095];
+        i0 += step * 8;
+    }
+
+    c_blob_data[gx] = c0 + c1;
+}
+)";
+
+static const char glsl_shared_store_data[] = R"(
+#version 450
+
+layout (constant_id = 0) const int loop = 1;
+layout (constant_id = 1) const int stride = 1;
+
+layout (binding = 0) writeonly buffer c_blob { float c_blob_data[]; };
+
+shared float tmp[4096];
+
+void main()
+{
+    const uint gx = gl_GlobalInvocationID.x;
+    const uint lx = gl_LocalInvocationID.x;
+    const uint step = gl_WorkGroupSize.x * uint(stride);
+
+    float c = float(gx);
+
+    uint i0 = lx * uint(stride);
+
+    for (int i = 0; i < loop; i++)
+    {
+        tmp[i0 & 4095] = c;
+        tmp[(i0 + step) & 4095] = c;
+        tmp[(i0 + step * 2) & 4095] = c;
+        tmp[(i0 + step * 3) & 4095] = c;
+        tmp[(i0 + step * 4) & 4095] = c;
+        tmp[(i0 + step * 5) & 4095] = c;
+        tmp[(i0 + step * 6) & 4095] = c;
+        tmp[(i0 + step * 7) & 4095] = c;
+        i0 += step * 8;
+        c += 1.f;
+    }
+
+    barrier();
+
+    c_blob_data[gx] = tmp[lx];
+}
+)";
+
+double vkpeak_shared(int loop, int count_mb, int cmd_loop, int access_type, int stride)
+{
+    ncnn::VulkanDevice* vkdev = vkpeak_get_device();
+
+    if (!vkdev)
+    {
+        return 0;
+    }
+
+    if (stride < 1)
+    {
+        return 0;
+    }
+
+    ncnn::Option opt;
+    opt.use_vulkan_compute = true;
+    opt.use_fp16_packed = false;
+    opt.use_fp16_storage = false;
+    opt.use_fp16_arithmetic = false;
+
+    vkpeak_kernel kernel;
+
+    // -1 for omit the tail '\0'
+    if (access_type == 0)
+        kernel.glsl.assign(glsl_shared_load_data, sizeof(glsl_shared_load_data) - 1);
+    if (access_type == 1)
+        kernel.glsl.assign(glsl_shared_store_data, sizeof(glsl_shared_store_data) - 1);
+
+    if (kernel.glsl.empty())
+    {
+        return 0;
+    }
+
+    // 8 shared fp32 accesses per loop
+    kernel.ops_per_loop = 8 * 4;
+    kernel.ops_tail = 0;
+
+    // a full workgroup of several subgroups keeps the shared memory pipe busy
+    int local_size_x = std::min(128, (int)vkdev->info.max_workgroup_size_x());
+    local_size_x = std::min(local_size_x, (int)vkdev->info.max_workgroup_invocations());
+    local_size_x = vkpeak_local_size(vkdev, local_size_x);
+
+    ncnn::VkAllocator* allocator = vkdev->acquire_blob_allocator();
+
+    int buffer_size = vkpeak_buffer_size(vkdev, count_mb);
+
+    ncnn::VkMat c(buffer_size, (size_t)1u, 1, allocator);
+
+    int max_invocation_count = buffer_size / 4;
+    // make max_invocation_count be multiple of local_size_x
+    max_invocation_count = std::max(max_invocation_count / local_size_x, 1) * local_size_x;
+
+    // start with little works
+    int invocation_count = std::max(max_invocation_count / 32, local_size_x) / local_size_x * local_size_x;
+
+    std::vector<ncnn::vk_specialization_type> specializations(2);
+    specializations[1].i = stride;
+
+    vkpeak_workload workload;
+    workload.vkdev = vkdev;
+    workload.opt = opt;
+    workload.kernels.push_back(kernel);
+    workload.specializations = specializations;
+    workload.bindings.push_back(c);
+    workload.local_size_x = local_size_x;
+    workload.invocation_count = invocation_count;
+    workload.max_invocation_count = max_invocation_count;
+    workload.split_queues = false;
+
+    double max_gbps = vkpeak_run(workload, loop, cmd_loop);
+
+    vkdev->reclaim_blob_allocator(allocator);
+
+    return max_gbps;
+}
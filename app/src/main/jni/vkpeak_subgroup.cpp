@@ -0,0 +1,252 @@
+// Tencent is pleased to support the open source community by making ncnn available.
+//
+// Copyright (C) 2025 THL A29 Limited, a Tencent company. All rights reserved.
+//
+// Licensed under the BSD 3-Clause License (the "License"); you may not use this file except
+// in compliance with the License. You may obtain a copy of the License at
+//
+// https://opensource.org/licenses/BSD-3-Clause
+//
+// Unless required by applicable law or agreed to in writing, software distributed
+// under the License is distributed on an "AS IS" BASIS, WITHOUT WARRANTIES OR
+// CONDITIONS OF ANY KIND, either express or implied. See the License for the
+// specific language governing permissions and limitations under the License.
+
+#include "vkpeak.h"
+#include "vkpeak_runner.h"
+
+#include <algorithm>
+#include <string>
+#include <vector>
+
+// ncnn
+#include <gpu.h>
+#include <mat.h>
+
+// the subgroup kernels share one body, T is the element type and OP is one subgroup op on c
+// add broadcast and ballot produce a subgroup uniform value, which compilers may reduce to a plain
+// multiply or a copy when fed back, so their operand mixes in the lane varying b
+static const char glsl_subgroup_data[] = R"(
+layout (constant_id = 0) const int loop = 1;
+
+layout (binding = 0) writeonly buffer c_blob { float c_blob_data[]; };
+
+void main()
+{
+    const uint gx = gl_GlobalInvocationID.x;
+    const uint sx = gl_SubgroupInvocationID;
+    const uint sid = (sx + 1) & (gl_SubgroupSize - 1);
+
+    T c = T(gx);
+    T b = T(sx);
+
+    for (int i = 0; i < loop; i++)
+    {
+        c = OP0(c);
+        c = OP1(c);
+        c = OP0(c);
+        c = OP1(c);
+        c = OP0(c);
+        c = OP1(c);
+        c = OP0(c);
+        c = OP1(c);
+        c = OP0(c);
+        c = OP1(c);
+        c = OP0(c);
+        c = OP1(c);
+        c = OP0(c);
+        c = OP1(c);
+        c = OP0(c);
+        c = OP1(c);
+    }
+
+    c_blob_data[gx] = float(c);
+}
+)";
+
+static const char glsl_subgroup_dual_data[] = R"(
+layout (constant_id = 0) const int loop = 1;
+
+layout (binding = 0) writeonly buffer c_blob { float c_blob_data[]; };
+
+void main()
+{
+    const uint gx = gl_GlobalInvocationID.x;
+    const uint sx = gl_SubgroupInvocationID;
+    const uint sid = (sx + 1) & (gl_SubgroupSize - 1);
+
+    T c0 = T(gx);
+    T c1 = T(sx);
+    T b = T(sx);
+
+    for (int i = 0; i < loop; i++)
+    {
+        c0 = OP0(c0);
+        c1 = OP0(c1);
+        c0 = OP1(c0);
+        c1 = OP1(c1);
+        c0 = OP0(c0);
+        c1 = OP0(c1);
+        c0 = OP1(c0);
+        c1 = OP1(c1);
+        c0 = OP0(c0);
+        c1 = OP0(c1);
+        c0 = OP1(c0);
+        c1 = OP1(c1);
+        c0 = OP0(c0);
+        c1 = OP0(c1);
+        c0 = OP1(c0);
+        c1 = OP1(c1);
+    }
+
+    c_blob_data[gx] = float(c0) + float(c1);
+}
+)";
+
+// OP0 and OP1 alternate so that back to back shuffle xor do not cancel out
+static const char* const subgroup_op_defines[5][2] = {
+    {"subgroupAdd(x + b)", "subgroupAdd(x + b)"},
+    {"subgroupShuffle(x, sid)", "subgroupShuffle(x, sid)"},
+    {"subgroupShuffleXor(x, 1u)", "subgroupShuffleXor(x, 2u)"},
+    {"subgroupBroadcast(x + b, 0u)", "subgroupBroadcast(x + b, 0u)"},
+    {"T(subgroupBallot(x > b).x)", "T(subgroupBallot(x > b).x)"},
+};
+
+// the subgroup extension and feature bit each op needs, broadcast lives in the ballot extension
+static const char* const subgroup_op_extensions[5] = {
+    "GL_KHR_shader_subgroup_arithmetic",
+    "GL_KHR_shader_subgroup_shuffle",
+    "GL_KHR_shader_subgroup_shuffle",
+    "GL_KHR_shader_subgroup_ballot",
+    "GL_KHR_shader_subgroup_ballot",
+};
+
+static const uint32_t subgroup_op_features[5] = {
+    VK_SUBGROUP_FEATURE_ARITHMETIC_BIT,
+    VK_SUBGROUP_FEATURE_SHUFFLE_BIT,
+    VK_SUBGROUP_FEATURE_SHUFFLE_BIT,
+    VK_SUBGROUP_FEATURE_BALLOT_BIT,
+    VK_SUBGROUP_FEATURE_BALLOT_BIT,
+};
+
+static std::string build_subgroup_glsl(const char* body, int arithmetic_type, int op_type)
+{
+    std::string glsl = "#version 450\n";
+
+    glsl += "#extension GL_KHR_shader_subgroup_basic: require\n";
+    glsl += std::string("#extension ") + subgroup_op_extensions[op_type] + ": require\n";
+
+    if (arithmetic_type == 1)
+    {
+        glsl += "#extension GL_EXT_shader_explicit_arithmetic_types_float16: require\n";
+        glsl += "#extension GL_EXT_shader_subgroup_extended_types_float16: require\n";
+        glsl += "#define T float16_t\n";
+    }
+    else if (arithmetic_type == 3)
+    {
+        glsl += "#define T int\n";
+    }
+    else // if (arithmetic_type == 0)
+    {
+        glsl += "#define T float\n";
+    }
+
+    glsl += std::string("#define OP0(x) ") + subgroup_op_defines[op_type][0] + "\n";
+    glsl += std::string("#define OP1(x) ") + subgroup_op_defines[op_type][1] + "\n";
+
+    glsl += body;
+
+    return glsl;
+}
+
+double vkpeak_subgroup(int loop, int count_mb, int cmd_loop, int arithmetic_type, int op_type)
+{
+    ncnn::VulkanDevice* vkdev = vkpeak_get_device();
+
+    if (!vkdev)
+    {
+        return 0;
+    }
+
+    if (arithmetic_type != 0 && arithmetic_type != 1 && arithmetic_type != 3)
+    {
+        return 0;
+    }
+    if (op_type < 0 || op_type > 4)
+    {
+        return 0;
+    }
+
+    // check subgroup operation feature
+    // the shader enables the basic extension and the one of op_type
+    const uint32_t required_ops = VK_SUBGROUP_FEATURE_BASIC_BIT | subgroup_op_features[op_type];
+    if ((vkdev->info.support_subgroup_ops() & required_ops) != required_ops)
+    {
+        return 0;
+    }
+
+    if (arithmetic_type == 1)
+    {
+        if (!vkdev->info.support_fp16_arithmetic())
+        {
+            return 0;
+        }
+
+        // check shader subgroup extended types feature
+        bool has_subgroup_extended_types = vkdev->info.queryShaderSubgroupExtendedTypesFeatures().shaderSubgroupExtendedTypes;
+        if (!has_subgroup_extended_types)
+        {
+            return 0;
+        }
+    }
+
+    ncnn::Option opt;
+    opt.use_vulkan_compute = true;
+    opt.use_fp16_packed = false;
+    opt.use_fp16_storage = false;
+    opt.use_fp16_arithmetic = arithmetic_type == 1;
+
+    // one subgroup op per statement, 16 statements per loop
+    vkpeak_kernel kernel;
+    kernel.glsl = build_subgroup_glsl(glsl_subgroup_data, arithmetic_type, op_type);
+    kernel.ops_per_loop = 16;
+    kernel.ops_tail = 0;
+
+    vkpeak_kernel kernel_dual;
+    kernel_dual.glsl = build_subgroup_glsl(glsl_subgroup_dual_data, arithmetic_type, op_type);
+    kernel_dual.ops_per_loop = 16;
+    kernel_dual.ops_tail = 0;
+
+    ncnn::VkAllocator* allocator = vkdev->acquire_blob_allocator();
+
+    int buffer_size = vkpeak_buffer_size(vkdev, count_mb);
+
+    ncnn::VkMat c(buffer_size, (size_t)1u, 1, allocator);
+
+    int local_size_x = vkpeak_local_size(vkdev, std::min(128, std::max(1, (int)vkdev->info.subgroup_size())));
+
+    int max_invocation_count = buffer_size / 4;
+    // make max_invocation_count be multiple of local_size_x
+    max_invocation_count = std::max(max_invocation_count / local_size_x, 1) * local_size_x;
+
+    // start with little works
+    int invocation_count = std::max(max_invocation_count / 32 / local_size_x, 1) * local_size_x;
+
+    vkpeak_workload workload;
+    workload.vkdev = vkdev;
+    workload.opt = opt;
+    workload.kernels.push_back(kernel);
+    workload.kernels.push_back(kernel_dual);
+    workload.specializations.resize(1);
+    workload.bindings.push_back(c);
+    workload.local_size_x = local_size_x;
+    workload.invocation_count = invocation_count;
+    workload.max_invocation_count = max_invocation_count;
+    workload.split_queues = true;
+
+    double max_gops = vkpeak_run(workload, loop, cmd_loop);
+
+    vkdev->reclaim_blob_allocator(allocator);
+
+    return max_gops;
+}
@@ -18,2415 +18,445 @@
 
 #include <jni.h>
 
-#include <float.h>
-#include <string>
+#include <stdio.h>
+
 #include <vector>
 
 // ncnn
-#include <benchmark.h>
-#include <command.h>
 #include <gpu.h>
-#include <mat.h>
-#include <pipeline.h>
-
-static const char glsl_p1_data[] = R"(
-#version 450
+#include <platform.h>
 
-layout (constant_id = 0) const int loop = 1;
+#include "vkpeak.h"
 
-layout (binding = 0) writeonly buffer c_blob { float c_blob_data[]; };
+// the device the app benchmarks, -1 = default device
+static int g_device_index = -1;
 
-void main()
+static ncnn::VulkanDevice* get_selected_gpu_device()
 {
-    const uint gx = gl_GlobalInvocationID.x;
-    const uint lx = gl_LocalInvocationID.x;
-
-    afp c = afp(gx);
-
-    afp a = c;
-    afp b = afp(lx);
-
-    for (int i = 0; i < loop; i++)
-    {
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-    }
-
-    c_blob_data[gx] = sfp(c);
+    return ncnn::get_gpu_device(g_device_index == -1 ? ncnn::get_default_gpu_index() : g_device_index);
 }
-)";
 
-static const char glsl_p1_dual_data[] = R"(
-#version 450
-
-layout (constant_id = 0) const int loop = 1;
-
-layout (binding = 0) writeonly buffer c_blob { float c_blob_data[]; };
+extern "C" {
 
-void main()
+JNIEXPORT jint JNI_OnLoad(JavaVM* vm, void* reserved)
 {
-    const uint gx = gl_GlobalInvocationID.x;
-    const uint lx = gl_LocalInvocationID.x;
-
-    afp c0 = afp(gx);
-    afp c1 = afp(lx);
-
-    afp a = c0;
-    afp b = c1;
+    __android_log_print(ANDROID_LOG_DEBUG, "VkPeakNcnn", "JNI_OnLoad");
 
-    for (int i = 0; i < loop; i++)
-    {
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-    }
+    ncnn::create_gpu_instance();
 
-    c0 = c0 + c1;
-    c_blob_data[gx] = sfp(c0);
+    return JNI_VERSION_1_4;
 }
-)";
-
-static const char glsl_p4_dual_data[] = R"(
-#version 450
-
-layout (constant_id = 0) const int loop = 1;
-
-layout (binding = 0) writeonly buffer c_blob { float c_blob_data[]; };
 
-void main()
+JNIEXPORT void JNI_OnUnload(JavaVM* vm, void* reserved)
 {
-    const uint gx = gl_GlobalInvocationID.x;
-    const uint lx = gl_LocalInvocationID.x;
-
-    afpvec4 c = afpvec4(gx);
-
-    afpvec4 a = c + afpvec4(0,1,2,-3);
-    afpvec4 b = afpvec4(lx) + afpvec4(2,3,5,-7);
-
-    for (int i = 0; i < loop; i++)
-    {
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-    }
+    __android_log_print(ANDROID_LOG_DEBUG, "VkPeakNcnn", "JNI_OnUnload");
 
-    c_blob_data[gx] = sfp((c[0] + c[1]) + (c[2] + c[3]));
+    ncnn::destroy_gpu_instance();
 }
-)";
-
-static const char glsl_p4_data[] = R"(
-#version 450
-
-layout (constant_id = 0) const int loop = 1;
-
-layout (binding = 0) writeonly buffer c_blob { float c_blob_data[]; };
 
-void main()
+// public native String GetPlatform();
+JNIEXPORT jstring JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_GetPlatform(JNIEnv* env, jobject thiz)
 {
-    const uint gx = gl_GlobalInvocationID.x;
-    const uint lx = gl_LocalInvocationID.x;
-
-    afpvec4 c0 = afpvec4(gx);
-    afpvec4 c1 = afpvec4(lx);
-
-    afpvec4 a = c0 + afpvec4(0,1,2,-3);
-    afpvec4 b = c1 + afpvec4(2,3,5,-7);
-
-    for (int i = 0; i < loop; i++)
-    {
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-    }
+    char platform[PROP_VALUE_MAX+1];
+    __system_property_get("ro.board.platform", platform);
 
-    c0 = c0 + c1;
-    c_blob_data[gx] = sfp((c0[0] + c0[1]) + (c0[2] + c0[3]));
+    return env->NewStringUTF(platform);
 }
-)";
 
-static const char glsl_fp64_p1_data[] = R"(
-#version 450
-
-layout (constant_id = 0) const int loop = 1;
-
-layout (binding = 0) writeonly buffer c_blob { double c_blob_data[]; };
-
-void main()
+// public native String GetNcnnVersion();
+JNIEXPORT jstring JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_GetNcnnVersion(JNIEnv* env, jobject thiz)
 {
-    const uint gx = gl_GlobalInvocationID.x;
-    const uint lx = gl_LocalInvocationID.x;
-
-    double c = double(gx);
-
-    double a = c;
-    double b = double(lx);
-
-    for (int i = 0; i < loop; i++)
-    {
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-    }
-
-    c_blob_data[gx] = c;
+    return env->NewStringUTF(NCNN_VERSION_STRING);
 }
-)";
-
-static const char glsl_fp64_p1_dual_data[] = R"(
-#version 450
-
-layout (constant_id = 0) const int loop = 1;
 
-layout (binding = 0) writeonly buffer c_blob { double c_blob_data[]; };
-
-void main()
+// public native int GetGpuCount();
+JNIEXPORT jint JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_GetGpuCount(JNIEnv* env, jobject thiz)
 {
-    const uint gx = gl_GlobalInvocationID.x;
-    const uint lx = gl_LocalInvocationID.x;
-
-    double c0 = double(gx);
-    double c1 = double(lx);
-
-    double a = c0;
-    double b = c1;
-
-    for (int i = 0; i < loop; i++)
-    {
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-    }
-
-    c0 = c0 + c1;
-    c_blob_data[gx] = c0;
+    return vkpeak_get_device_count();
 }
-)";
-
-static const char glsl_fp64_p4_data[] = R"(
-#version 450
 
-layout (constant_id = 0) const int loop = 1;
-
-layout (binding = 0) writeonly buffer c_blob { double c_blob_data[]; };
-
-void main()
+// public native void SetDevice(int device_index);
+JNIEXPORT void JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_SetDevice(JNIEnv* env, jobject thiz, jint device_index)
 {
-    const uint gx = gl_GlobalInvocationID.x;
-    const uint lx = gl_LocalInvocationID.x;
-
-    dvec4 c = dvec4(gx);
-
-    dvec4 a = c + dvec4(0,1,2,-3);
-    dvec4 b = dvec4(lx) + dvec4(2,3,5,-7);
-
-    for (int i = 0; i < loop; i++)
-    {
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-    }
-
-    c_blob_data[gx] = (c[0] + c[1]) + (c[2] + c[3]);
+    g_device_index = device_index;
 }
-)";
-
-static const char glsl_fp64_p4_dual_data[] = R"(
-#version 450
-
-layout (constant_id = 0) const int loop = 1;
-
-layout (binding = 0) writeonly buffer c_blob { double c_blob_data[]; };
 
-void main()
+// public native String GetVkDevice();
+JNIEXPORT jstring JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_GetVkDevice(JNIEnv* env, jobject thiz)
 {
-    const uint gx = gl_GlobalInvocationID.x;
-    const uint lx = gl_LocalInvocationID.x;
-
-    dvec4 c0 = dvec4(gx);
-    dvec4 c1 = dvec4(lx);
-
-    dvec4 a = c0 + dvec4(0,1,2,-3);
-    dvec4 b = c1 + dvec4(2,3,5,-7);
-
-    for (int i = 0; i < loop; i++)
+    ncnn::VulkanDevice* vkdev = get_selected_gpu_device();
+    if (!vkdev)
     {
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
+        return env->NewStringUTF("No vulkan device");
     }
 
-    c0 = c0 + c1;
-    c_blob_data[gx] = (c0[0] + c0[1]) + (c0[2] + c0[3]);
+    return env->NewStringUTF(vkdev->info.device_name());
 }
-)";
-
-static const char glsl_int32_p1_data[] = R"(
-#version 450
-
-layout (constant_id = 0) const int loop = 1;
 
-layout (binding = 0) writeonly buffer c_blob { int c_blob_data[]; };
-
-void main()
+// public native String GetApiVersion();
+JNIEXPORT jstring JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_GetApiVersion(JNIEnv* env, jobject thiz)
 {
-    const uint gx = gl_GlobalInvocationID.x;
-    const uint lx = gl_LocalInvocationID.x;
-
-    int c = int(gx);
-
-    int a = c;
-    int b = int(lx);
-
-    for (int i = 0; i < loop; i++)
+    ncnn::VulkanDevice* vkdev = get_selected_gpu_device();
+    if (!vkdev)
     {
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
+        return env->NewStringUTF("No vulkan device");
     }
 
-    c_blob_data[gx] = c;
-}
-)";
-
-static const char glsl_int32_p1_dual_data[] = R"(
-#version 450
-
-layout (constant_id = 0) const int loop = 1;
-
-layout (binding = 0) writeonly buffer c_blob { int c_blob_data[]; };
-
-void main()
-{
-    const uint gx = gl_GlobalInvocationID.x;
-    const uint lx = gl_LocalInvocationID.x;
-
-    int c0 = int(gx);
-    int c1 = int(lx);
-
-    int a = c0;
-    int b = c1;
+    uint32_t api_version = vkdev->info.api_version();
 
-    for (int i = 0; i < loop; i++)
-    {
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-    }
+    char tmp[128];
+    sprintf(tmp, "%u.%u.%u", VK_VERSION_MAJOR(api_version), VK_VERSION_MINOR(api_version), VK_VERSION_PATCH(api_version));
 
-    c0 = c0 + c1;
-    c_blob_data[gx] = c0;
+    return env->NewStringUTF(tmp);
 }
-)";
-
-static const char glsl_int32_p4_data[] = R"(
-#version 450
-
-layout (constant_id = 0) const int loop = 1;
-
-layout (binding = 0) writeonly buffer c_blob { int c_blob_data[]; };
 
-void main()
+// public native String GetDriverVersion();
+JNIEXPORT jstring JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_GetDriverVersion(JNIEnv* env, jobject thiz)
 {
-    const uint gx = gl_GlobalInvocationID.x;
-    const uint lx = gl_LocalInvocationID.x;
-
-    ivec4 c = ivec4(gx);
-
-    ivec4 a = c + ivec4(0,1,2,-3);
-    ivec4 b = ivec4(lx) + ivec4(2,3,5,-7);
-
-    for (int i = 0; i < loop; i++)
+    ncnn::VulkanDevice* vkdev = get_selected_gpu_device();
+    if (!vkdev)
     {
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
+        return env->NewStringUTF("No vulkan device");
     }
 
-    c_blob_data[gx] = (c[0] + c[1]) + (c[2] + c[3]);
-}
-)";
-
-static const char glsl_int32_p4_dual_data[] = R"(
-#version 450
-
-layout (constant_id = 0) const int loop = 1;
-
-layout (binding = 0) writeonly buffer c_blob { int c_blob_data[]; };
-
-void main()
-{
-    const uint gx = gl_GlobalInvocationID.x;
-    const uint lx = gl_LocalInvocationID.x;
-
-    ivec4 c0 = ivec4(gx);
-    ivec4 c1 = ivec4(lx);
-
-    ivec4 a = c0 + ivec4(0,1,2,-3);
-    ivec4 b = c1 + ivec4(2,3,5,-7);
+    uint32_t driver_version = vkdev->info.driver_version();
 
-    for (int i = 0; i < loop; i++)
-    {
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-    }
+    char tmp[128];
+    sprintf(tmp, "%u.%u.%u", VK_VERSION_MAJOR(driver_version), VK_VERSION_MINOR(driver_version), VK_VERSION_PATCH(driver_version));
 
-    c0 = c0 + c1;
-    c_blob_data[gx] = (c0[0] + c0[1]) + (c0[2] + c0[3]);
+    return env->NewStringUTF(tmp);
 }
-)";
-
-static const char glsl_int16_p1_data[] = R"(
-#version 450
-
-#extension GL_EXT_shader_explicit_arithmetic_types_int16: require
-
-layout (constant_id = 0) const int loop = 1;
-
-layout (binding = 0) writeonly buffer c_blob { int c_blob_data[]; };
 
-void main()
+// public native void SetCacheDir(String cache_dir);
+JNIEXPORT void JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_SetCacheDir(JNIEnv* env, jobject thiz, jstring cache_dir)
 {
-    const uint gx = gl_GlobalInvocationID.x;
-    const uint lx = gl_LocalInvocationID.x;
+    const char* path = env->GetStringUTFChars(cache_dir, 0);
 
-    int16_t c = int16_t(gx);
+    vkpeak_set_cache_dir(path);
 
-    int16_t a = c;
-    int16_t b = int16_t(lx);
-
-    for (int i = 0; i < loop; i++)
-    {
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-    }
-
-    c_blob_data[gx] = int(c);
+    env->ReleaseStringUTFChars(cache_dir, path);
 }
-)";
-
-static const char glsl_int16_p1_dual_data[] = R"(
-#version 450
-
-#extension GL_EXT_shader_explicit_arithmetic_types_int16: require
-
-layout (constant_id = 0) const int loop = 1;
 
-layout (binding = 0) writeonly buffer c_blob { int c_blob_data[]; };
-
-void main()
+// public native void SetLoopType(int loop_type);
+JNIEXPORT void JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_SetLoopType(JNIEnv* env, jobject thiz, jint loop_type)
 {
-    const uint gx = gl_GlobalInvocationID.x;
-    const uint lx = gl_LocalInvocationID.x;
-
-    int16_t c0 = int16_t(gx);
-    int16_t c1 = int16_t(lx);
-
-    int16_t a = c0;
-    int16_t b = c1;
-
-    for (int i = 0; i < loop; i++)
-    {
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-    }
-
-    c0 = c0 + c1;
-    c_blob_data[gx] = int(c0);
+    vkpeak_set_loop_type(loop_type);
 }
-)";
 
-static const char glsl_int16_p4_data[] = R"(
-#version 450
-
-#extension GL_EXT_shader_explicit_arithmetic_types_int16: require
-
-layout (constant_id = 0) const int loop = 1;
-
-layout (binding = 0) writeonly buffer c_blob { int c_blob_data[]; };
-
-void main()
+// public native void SetDispatchCount(int dispatch_count);
+JNIEXPORT void JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_SetDispatchCount(JNIEnv* env, jobject thiz, jint dispatch_count)
 {
-    const uint gx = gl_GlobalInvocationID.x;
-    const uint lx = gl_LocalInvocationID.x;
-
-    i16vec4 c = i16vec4(gx);
-
-    i16vec4 a = c + i16vec4(0,1,2,-3);
-    i16vec4 b = i16vec4(lx) + i16vec4(2,3,5,-7);
-
-    for (int i = 0; i < loop; i++)
-    {
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-        c = a * c + b;
-    }
-
-    c_blob_data[gx] = int((c[0] + c[1]) + (c[2] + c[3]));
+    vkpeak_set_dispatch_count(dispatch_count);
 }
-)";
-
-static const char glsl_int16_p4_dual_data[] = R"(
-#version 450
-
-#extension GL_EXT_shader_explicit_arithmetic_types_int16: require
-
-layout (constant_id = 0) const int loop = 1;
-
-layout (binding = 0) writeonly buffer c_blob { int c_blob_data[]; };
 
-void main()
+// public native void SetQueueCount(int queue_count);
+JNIEXPORT void JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_SetQueueCount(JNIEnv* env, jobject thiz, jint queue_count)
 {
-    const uint gx = gl_GlobalInvocationID.x;
-    const uint lx = gl_LocalInvocationID.x;
-
-    i16vec4 c0 = i16vec4(gx);
-    i16vec4 c1 = i16vec4(lx);
-
-    i16vec4 a = c0 + i16vec4(0,1,2,-3);
-    i16vec4 b = c1 + i16vec4(2,3,5,-7);
-
-    for (int i = 0; i < loop; i++)
-    {
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-        c0 = a * c0 + b;
-        c1 = a * c1 + b;
-    }
-
-    c0 = c0 + c1;
-    c_blob_data[gx] = int((c0[0] + c0[1]) + (c0[2] + c0[3]));
+    vkpeak_set_queue_count(queue_count);
 }
-)";
-
-static const char glsl_int8_p4_data[] = R"(
-#version 450
 
-#extension GL_EXT_integer_dot_product: require
-
-layout (constant_id = 0) const int loop = 1;
-
-layout (binding = 0) writeonly buffer c_blob { int c_blob_data[]; };
-
-void main()
+// public native void SetSampler(float cv_threshold, int time_budget_ms);
+JNIEXPORT void JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_SetSampler(JNIEnv* env, jobject thiz, jfloat cv_threshold, jint time_budget_ms)
 {
-    const uint gx = gl_GlobalInvocationID.x;
-    const uint lx = gl_LocalInvocationID.x;
-
-    int c = int(gx);
-
-    int a = int(gx);
-    int b = int(lx);
-
-    for (int i = 0; i < loop; i++)
-    {
-        c = dotPacked4x8AccSatEXT(a, b, c);
-        c = dotPacked4x8AccSatEXT(a, b, c);
-        c = dotPacked4x8AccSatEXT(a, b, c);
-        c = dotPacked4x8AccSatEXT(a, b, c);
-        c = dotPacked4x8AccSatEXT(a, b, c);
-        c = dotPacked4x8AccSatEXT(a, b, c);
-        c = dotPacked4x8AccSatEXT(a, b, c);
-        c = dotPacked4x8AccSatEXT(a, b, c);
-        c = dotPacked4x8AccSatEXT(a, b, c);
-        c = dotPacked4x8AccSatEXT(a, b, c);
-        c = dotPacked4x8AccSatEXT(a, b, c);
-        c = dotPacked4x8AccSatEXT(a, b, c);
-        c = dotPacked4x8AccSatEXT(a, b, c);
-        c = dotPacked4x8AccSatEXT(a, b, c);
-        c = dotPacked4x8AccSatEXT(a, b, c);
-        c = dotPacked4x8AccSatEXT(a, b, c);
-    }
-
-    c_blob_data[gx] = c;
+    vkpeak_set_sampler(cv_threshold, time_budget_ms);
 }
-)";
-
-static const char glsl_int8_p4_dual_data[] = R"(
-#version 450
-
-#extension GL_EXT_integer_dot_product: require
-
-layout (constant_id = 0) const int loop = 1;
 
-layout (binding = 0) writeonly buffer c_blob { int c_blob_data[]; };
-
-void main()
+// public native float[] GetLastStats();
+JNIEXPORT jfloatArray JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_GetLastStats(JNIEnv* env, jobject thiz)
 {
-    const uint gx = gl_GlobalInvocationID.x;
-    const uint lx = gl_LocalInvocationID.x;
+    vkpeak_stats stats;
+    vkpeak_get_last_stats(&stats);
 
-    int c0 = int(gx);
-    int c1 = int(lx);
+    const jfloat values[6] = {(jfloat)stats.median, (jfloat)stats.p10, (jfloat)stats.p90, (jfloat)stats.max, (jfloat)stats.cv, (jfloat)stats.sample_count};
 
-    int a = int(gx);
-    int b = int(lx);
+    jfloatArray result = env->NewFloatArray(6);
+    env->SetFloatArrayRegion(result, 0, 6, values);
 
-    for (int i = 0; i < loop; i++)
-    {
-        c0 = dotPacked4x8AccSatEXT(a, b, c0);
-        c1 = dotPacked4x8AccSatEXT(a, b, c1);
-        c0 = dotPacked4x8AccSatEXT(a, b, c0);
-        c1 = dotPacked4x8AccSatEXT(a, b, c1);
-        c0 = dotPacked4x8AccSatEXT(a, b, c0);
-        c1 = dotPacked4x8AccSatEXT(a, b, c1);
-        c0 = dotPacked4x8AccSatEXT(a, b, c0);
-        c1 = dotPacked4x8AccSatEXT(a, b, c1);
-        c0 = dotPacked4x8AccSatEXT(a, b, c0);
-        c1 = dotPacked4x8AccSatEXT(a, b, c1);
-        c0 = dotPacked4x8AccSatEXT(a, b, c0);
-        c1 = dotPacked4x8AccSatEXT(a, b, c1);
-        c0 = dotPacked4x8AccSatEXT(a, b, c0);
-        c1 = dotPacked4x8AccSatEXT(a, b, c1);
-        c0 = dotPacked4x8AccSatEXT(a, b, c0);
-        c1 = dotPacked4x8AccSatEXT(a, b, c1);
-    }
-
-    c0 = c0 + c1;
-    c_blob_data[gx] = c0;
+    return result;
 }
-)";
-
-static const char glsl_bf16_p4_data[] = R"(
-#version 450
-
-#extension GL_EXT_shader_explicit_arithmetic_types : require
-#extension GL_EXT_bfloat16: require
-
-layout (constant_id = 0) const int loop = 1;
 
-layout (binding = 0) writeonly buffer c_blob { float c_blob_data[]; };
-
-void main()
+// public native void SetLocalSize(int local_size_x);
+JNIEXPORT void JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_SetLocalSize(JNIEnv* env, jobject thiz, jint local_size_x)
 {
-    const uint gx = gl_GlobalInvocationID.x;
-    const uint lx = gl_LocalInvocationID.x;
-
-    bfloat16_t c = bfloat16_t(gx);
-
-    u16vec4 a = uint16_t(gx) + u16vec4(0,1,2,3);
-    bf16vec4 b = uintBitsToBFloat16EXT(uint16_t(lx) + u16vec4(2,3,5,7));
-
-    for (int i = 0; i < loop; i++)
-    {
-        c = dot(uintBitsToBFloat16EXT(a), b);
-        a.x = bfloat16BitsToUintEXT(c);
-        c = dot(uintBitsToBFloat16EXT(a), b);
-        a.y = bfloat16BitsToUintEXT(c);
-        c = dot(uintBitsToBFloat16EXT(a), b);
-        a.z = bfloat16BitsToUintEXT(c);
-        c = dot(uintBitsToBFloat16EXT(a), b);
-        a.w = bfloat16BitsToUintEXT(c);
-        c = dot(uintBitsToBFloat16EXT(a), b);
-        a.x = bfloat16BitsToUintEXT(c);
-        c = dot(uintBitsToBFloat16EXT(a), b);
-        a.y = bfloat16BitsToUintEXT(c);
-        c = dot(uintBitsToBFloat16EXT(a), b);
-        a.z = bfloat16BitsToUintEXT(c);
-        c = dot(uintBitsToBFloat16EXT(a), b);
-        a.w = bfloat16BitsToUintEXT(c);
-        c = dot(uintBitsToBFloat16EXT(a), b);
-        a.x = bfloat16BitsToUintEXT(c);
-        c = dot(uintBitsToBFloat16EXT(a), b);
-        a.y = bfloat16BitsToUintEXT(c);
-        c = dot(uintBitsToBFloat16EXT(a), b);
-        a.z = bfloat16BitsToUintEXT(c);
-        c = dot(uintBitsToBFloat16EXT(a), b);
-        a.w = bfloat16BitsToUintEXT(c);
-        c = dot(uintBitsToBFloat16EXT(a), b);
-        a.x = bfloat16BitsToUintEXT(c);
-        c = dot(uintBitsToBFloat16EXT(a), b);
-        a.y = bfloat16BitsToUintEXT(c);
-        c = dot(uintBitsToBFloat16EXT(a), b);
-        a.z = bfloat16BitsToUintEXT(c);
-        c = dot(uintBitsToBFloat16EXT(a), b);
-        a.w = bfloat16BitsToUintEXT(c);
-    }
-
-    c_blob_data[gx] = float(c);
+    vkpeak_set_local_size(local_size_x);
 }
-)";
-
-static const char glsl_bf16_p4_dual_data[] = R"(
-#version 450
-
-#extension GL_EXT_shader_explicit_arithmetic_types : require
-#extension GL_EXT_bfloat16: require
-
-layout (constant_id = 0) const int loop = 1;
 
-layout (binding = 0) writeonly buffer c_blob { float c_blob_data[]; };
-
-void main()
+// public native void SetSustained(int duration_ms);
+JNIEXPORT void JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_SetSustained(JNIEnv* env, jobject thiz, jint duration_ms)
 {
-    const uint gx = gl_GlobalInvocationID.x;
-    const uint lx = gl_LocalInvocationID.x;
-
-    bfloat16_t c0 = bfloat16_t(gx);
-    bfloat16_t c1 = bfloat16_t(lx);
-
-    u16vec4 a0 = uint16_t(gx) + u16vec4(0,1,2,3);
-    u16vec4 a1 = uint16_t(gx) + u16vec4(10,21,32,43);
-    bf16vec4 b = uintBitsToBFloat16EXT(uint16_t(lx) + u16vec4(2,3,5,7));
-
-    for (int i = 0; i < loop; i++)
-    {
-        c0 = dot(uintBitsToBFloat16EXT(a0), b);
-        a0.x = bfloat16BitsToUintEXT(c0);
-        c1 = dot(uintBitsToBFloat16EXT(a1), b);
-        a1.y = bfloat16BitsToUintEXT(c1);
-        c0 = dot(uintBitsToBFloat16EXT(a0), b);
-        a0.z = bfloat16BitsToUintEXT(c0);
-        c1 = dot(uintBitsToBFloat16EXT(a1), b);
-        a1.w = bfloat16BitsToUintEXT(c1);
-        c0 = dot(uintBitsToBFloat16EXT(a0), b);
-        a0.x = bfloat16BitsToUintEXT(c0);
-        c1 = dot(uintBitsToBFloat16EXT(a1), b);
-        a1.y = bfloat16BitsToUintEXT(c1);
-        c0 = dot(uintBitsToBFloat16EXT(a0), b);
-        a0.z = bfloat16BitsToUintEXT(c0);
-        c1 = dot(uintBitsToBFloat16EXT(a1), b);
-        a1.w = bfloat16BitsToUintEXT(c1);
-        c0 = dot(uintBitsToBFloat16EXT(a0), b);
-        a0.x = bfloat16BitsToUintEXT(c0);
-        c1 = dot(uintBitsToBFloat16EXT(a1), b);
-        a1.y = bfloat16BitsToUintEXT(c1);
-        c0 = dot(uintBitsToBFloat16EXT(a0), b);
-        a0.z = bfloat16BitsToUintEXT(c0);
-        c1 = dot(uintBitsToBFloat16EXT(a1), b);
-        a1.w = bfloat16BitsToUintEXT(c1);
-        c0 = dot(uintBitsToBFloat16EXT(a0), b);
-        a0.x = bfloat16BitsToUintEXT(c0);
-        c1 = dot(uintBitsToBFloat16EXT(a1), b);
-        a1.y = bfloat16BitsToUintEXT(c1);
-        c0 = dot(uintBitsToBFloat16EXT(a0), b);
-        a0.z = bfloat16BitsToUintEXT(c0);
-        c1 = dot(uintBitsToBFloat16EXT(a1), b);
-        a1.w = bfloat16BitsToUintEXT(c1);
-    }
-
-    c_blob_data[gx] = float(c0) + float(c1);
+    vkpeak_set_sustained(duration_ms);
 }
-)";
 
-static const char glsl_fp16_matrix_nv_data[] = R"(
-#version 450
-
-#extension GL_EXT_shader_explicit_arithmetic_types_float16: require
-#extension GL_KHR_memory_scope_semantics: require
-#extension GL_EXT_shader_explicit_arithmetic_types: require
-#extension GL_NV_cooperative_matrix: require
-
-layout (constant_id = 0) const int loop = 1;
-layout (constant_id = 1) const int M = 1;
-layout (constant_id = 2) const int N = 1;
-layout (constant_id = 3) const int K = 1;
-
-layout (binding = 0) writeonly buffer c_blob { float c_blob_data[]; };
-
-void main()
+// public native float[] GetSustained();
+JNIEXPORT jfloatArray JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_GetSustained(JNIEnv* env, jobject thiz)
 {
-    const uint gx = gl_GlobalInvocationID.x;
-    const uint lx = gl_LocalInvocationID.x;
+    vkpeak_sustained sustained;
+    vkpeak_get_sustained(&sustained);
 
-    fcoopmatNV<16, gl_ScopeSubgroup, M, K> a = fcoopmatNV<16, gl_ScopeSubgroup, M, K>(float(gx));
-    fcoopmatNV<16, gl_ScopeSubgroup, K, N> b = fcoopmatNV<16, gl_ScopeSubgroup, K, N>(float(lx));
+    const jfloat values[5] = {(jfloat)sustained.peak, (jfloat)sustained.steady, (jfloat)sustained.steady_ratio, (jfloat)sustained.throttle_ms, (jfloat)sustained.sample_count};
 
-    fcoopmatNV<16, gl_ScopeSubgroup, M, N> c = fcoopmatNV<16, gl_ScopeSubgroup, M, N>(float(gx));
-
-    for (int i = 0; i < loop; i++)
-    {
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-    }
+    jfloatArray result = env->NewFloatArray(5);
+    env->SetFloatArrayRegion(result, 0, 5, values);
 
-    coopMatStoreNV(c, c_blob_data, gx * (M * N) / 2, N / 2, false);
+    return result;
 }
-)";
 
-static const char glsl_fp16_matrix_dual_nv_data[] = R"(
-#version 450
-
-#extension GL_EXT_shader_explicit_arithmetic_types_float16: require
-#extension GL_KHR_memory_scope_semantics: require
-#extension GL_EXT_shader_explicit_arithmetic_types: require
-#extension GL_NV_cooperative_matrix: require
-
-layout (constant_id = 0) const int loop = 1;
-layout (constant_id = 1) const int M = 1;
-layout (constant_id = 2) const int N = 1;
-layout (constant_id = 3) const int K = 1;
-
-layout (binding = 0) writeonly buffer c_blob { float c_blob_data[]; };
-
-void main()
+// public native float[] GetSustainedSamples();
+JNIEXPORT jfloatArray JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_GetSustainedSamples(JNIEnv* env, jobject thiz)
 {
-    const uint gx = gl_GlobalInvocationID.x;
-    const uint lx = gl_LocalInvocationID.x;
+    vkpeak_sustained sustained;
+    vkpeak_get_sustained(&sustained);
 
-    fcoopmatNV<16, gl_ScopeSubgroup, M, K> a = fcoopmatNV<16, gl_ScopeSubgroup, M, K>(float(gx));
-    fcoopmatNV<16, gl_ScopeSubgroup, K, N> b = fcoopmatNV<16, gl_ScopeSubgroup, K, N>(float(lx));
+    std::vector<double> times(sustained.sample_count);
+    std::vector<double> values(sustained.sample_count);
+    int count = vkpeak_get_sustained_samples(times.data(), values.data(), sustained.sample_count);
 
-    fcoopmatNV<16, gl_ScopeSubgroup, M, N> c0 = fcoopmatNV<16, gl_ScopeSubgroup, M, N>(float(gx));
-    fcoopmatNV<16, gl_ScopeSubgroup, M, N> c1 = fcoopmatNV<16, gl_ScopeSubgroup, M, N>(float(lx));
-
-    for (int i = 0; i < loop; i++)
+    // time and value interleaved
+    std::vector<jfloat> pairs(count * 2);
+    for (int i = 0; i < count; i++)
     {
-        c0 = coopMatMulAddNV(a, b, c0);
-        c1 = coopMatMulAddNV(a, b, c1);
-        c0 = coopMatMulAddNV(a, b, c0);
-        c1 = coopMatMulAddNV(a, b, c1);
-        c0 = coopMatMulAddNV(a, b, c0);
-        c1 = coopMatMulAddNV(a, b, c1);
-        c0 = coopMatMulAddNV(a, b, c0);
-        c1 = coopMatMulAddNV(a, b, c1);
-        c0 = coopMatMulAddNV(a, b, c0);
-        c1 = coopMatMulAddNV(a, b, c1);
-        c0 = coopMatMulAddNV(a, b, c0);
-        c1 = coopMatMulAddNV(a, b, c1);
-        c0 = coopMatMulAddNV(a, b, c0);
-        c1 = coopMatMulAddNV(a, b, c1);
-        c0 = coopMatMulAddNV(a, b, c0);
-        c1 = coopMatMulAddNV(a, b, c1);
+        pairs[i * 2] = (jfloat)times[i];
+        pairs[i * 2 + 1] = (jfloat)values[i];
     }
 
-    c0 = c0 + c1;
-    coopMatStoreNV(c0, c_blob_data, gx * (M * N) / 2, N / 2, false);
-}
-)";
-
-static const char glsl_fp16_matrix_khr_data[] = R"(
-#version 450
+    jfloatArray result = env->NewFloatArray(count * 2);
+    env->SetFloatArrayRegion(result, 0, count * 2, pairs.data());
 
-#extension GL_EXT_shader_explicit_arithmetic_types_float16: require
-#extension GL_KHR_memory_scope_semantics: require
-#extension GL_EXT_shader_explicit_arithmetic_types: require
-#extension GL_KHR_cooperative_matrix: require
-
-layout (constant_id = 0) const int loop = 1;
-layout (constant_id = 1) const int M = 1;
-layout (constant_id = 2) const int N = 1;
-layout (constant_id = 3) const int K = 1;
-
-layout (binding = 0) writeonly buffer c_blob { float c_blob_data[]; };
+    return result;
+}
 
-void main()
+// public native float Run(int loop, int count_mb, int cmd_loop, int storage_type, int arithmetic_type, int packing_type);
+JNIEXPORT jfloat JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_Run(JNIEnv* env, jobject thiz, jint loop, jint count_mb, jint cmd_loop, jint storage_type, jint arithmetic_type, jint packing_type)
 {
-    const uint gx = gl_GlobalInvocationID.x;
-    const uint lx = gl_LocalInvocationID.x;
-
-    coopmat<float16_t, gl_ScopeSubgroup, M, K, gl_MatrixUseA> a = coopmat<float16_t, gl_ScopeSubgroup, M, K, gl_MatrixUseA>(float(gx));
-    coopmat<float16_t, gl_ScopeSubgroup, K, N, gl_MatrixUseB> b = coopmat<float16_t, gl_ScopeSubgroup, K, N, gl_MatrixUseB>(float(lx));
-
-    coopmat<float16_t, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator> c = coopmat<float16_t, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator>(float(gx));
+    // the selection is per thread in vkpeak, apply it on the thread that runs the benchmark
+    vkpeak_set_device_index(g_device_index);
 
-    for (int i = 0; i < loop; i++)
-    {
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-    }
+    double gflops = vkpeak(loop, count_mb, cmd_loop, storage_type, arithmetic_type, packing_type);
 
-    coopMatStore(c, c_blob_data, gx * (M * N) / 2, N / 2, gl_CooperativeMatrixLayoutRowMajor);
+    return (jfloat)gflops;
 }
-)";
-
-static const char glsl_fp16_matrix_dual_khr_data[] = R"(
-#version 450
-
-#extension GL_EXT_shader_explicit_arithmetic_types_float16: require
-#extension GL_KHR_memory_scope_semantics: require
-#extension GL_EXT_shader_explicit_arithmetic_types: require
-#extension GL_KHR_cooperative_matrix: require
-
-layout (constant_id = 0) const int loop = 1;
-layout (constant_id = 1) const int M = 1;
-layout (constant_id = 2) const int N = 1;
-layout (constant_id = 3) const int K = 1;
-
-layout (binding = 0) writeonly buffer c_blob { float c_blob_data[]; };
 
-void main()
+// public native float RunCustom(int loop, int count_mb, int cmd_loop, int storage_type, int arithmetic_type, int packing_type, int unroll, int chains);
+JNIEXPORT jfloat JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_RunCustom(JNIEnv* env, jobject thiz, jint loop, jint count_mb, jint cmd_loop, jint storage_type, jint arithmetic_type, jint packing_type, jint unroll, jint chains)
 {
-    const uint gx = gl_GlobalInvocationID.x;
-    const uint lx = gl_LocalInvocationID.x;
+    vkpeak_set_device_index(g_device_index);
 
-    coopmat<float16_t, gl_ScopeSubgroup, M, K, gl_MatrixUseA> a = coopmat<float16_t, gl_ScopeSubgroup, M, K, gl_MatrixUseA>(float(gx));
-    coopmat<float16_t, gl_ScopeSubgroup, K, N, gl_MatrixUseB> b = coopmat<float16_t, gl_ScopeSubgroup, K, N, gl_MatrixUseB>(float(lx));
+    double gflops = vkpeak_custom(loop, count_mb, cmd_loop, storage_type, arithmetic_type, packing_type, unroll, chains);
 
-    coopmat<float16_t, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator> c0 = coopmat<float16_t, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator>(float(gx));
-    coopmat<float16_t, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator> c1 = coopmat<float16_t, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator>(float(lx));
-
-    for (int i = 0; i < loop; i++)
-    {
-        c0 = coopMatMulAdd(a, b, c0);
-        c1 = coopMatMulAdd(a, b, c1);
-        c0 = coopMatMulAdd(a, b, c0);
-        c1 = coopMatMulAdd(a, b, c1);
-        c0 = coopMatMulAdd(a, b, c0);
-        c1 = coopMatMulAdd(a, b, c1);
-        c0 = coopMatMulAdd(a, b, c0);
-        c1 = coopMatMulAdd(a, b, c1);
-        c0 = coopMatMulAdd(a, b, c0);
-        c1 = coopMatMulAdd(a, b, c1);
-        c0 = coopMatMulAdd(a, b, c0);
-        c1 = coopMatMulAdd(a, b, c1);
-        c0 = coopMatMulAdd(a, b, c0);
-        c1 = coopMatMulAdd(a, b, c1);
-        c0 = coopMatMulAdd(a, b, c0);
-        c1 = coopMatMulAdd(a, b, c1);
-    }
-
-    c0 = c0 + c1;
-    coopMatStore(c0, c_blob_data, gx * (M * N) / 2, N / 2, gl_CooperativeMatrixLayoutRowMajor);
+    return (jfloat)gflops;
 }
-)";
-
-static const char glsl_fp16_fp32_matrix_nv_data[] = R"(
-#version 450
-
-#extension GL_EXT_shader_explicit_arithmetic_types_float16: require
-#extension GL_KHR_memory_scope_semantics: require
-#extension GL_EXT_shader_explicit_arithmetic_types: require
-#extension GL_NV_cooperative_matrix: require
 
-layout (constant_id = 0) const int loop = 1;
-layout (constant_id = 1) const int M = 1;
-layout (constant_id = 2) const int N = 1;
-layout (constant_id = 3) const int K = 1;
-
-layout (binding = 0) writeonly buffer c_blob { float c_blob_data[]; };
-
-void main()
+// public native float RunIlp(int loop, int count_mb, int cmd_loop, int storage_type, int arithmetic_type, int packing_type, int chains);
+JNIEXPORT jfloat JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_RunIlp(JNIEnv* env, jobject thiz, jint loop, jint count_mb, jint cmd_loop, jint storage_type, jint arithmetic_type, jint packing_type, jint chains)
 {
-    const uint gx = gl_GlobalInvocationID.x;
-    const uint lx = gl_LocalInvocationID.x;
+    vkpeak_set_device_index(g_device_index);
 
-    fcoopmatNV<16, gl_ScopeSubgroup, M, K> a = fcoopmatNV<16, gl_ScopeSubgroup, M, K>(float(gx));
-    fcoopmatNV<16, gl_ScopeSubgroup, K, N> b = fcoopmatNV<16, gl_ScopeSubgroup, K, N>(float(lx));
+    double gflops = vkpeak_ilp(loop, count_mb, cmd_loop, storage_type, arithmetic_type, packing_type, chains);
 
-    fcoopmatNV<32, gl_ScopeSubgroup, M, N> c = fcoopmatNV<32, gl_ScopeSubgroup, M, N>(float(gx));
-
-    for (int i = 0; i < loop; i++)
-    {
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-    }
-
-    coopMatStoreNV(c, c_blob_data, gx * (M * N), N, false);
+    return (jfloat)gflops;
 }
-)";
 
-static const char glsl_fp16_fp32_matrix_dual_nv_data[] = R"(
-#version 450
-
-#extension GL_EXT_shader_explicit_arithmetic_types_float16: require
-#extension GL_KHR_memory_scope_semantics: require
-#extension GL_EXT_shader_explicit_arithmetic_types: require
-#extension GL_NV_cooperative_matrix: require
-
-layout (constant_id = 0) const int loop = 1;
-layout (constant_id = 1) const int M = 1;
-layout (constant_id = 2) const int N = 1;
-layout (constant_id = 3) const int K = 1;
-
-layout (binding = 0) writeonly buffer c_blob { float c_blob_data[]; };
-
-void main()
+// public native String[] GetMatrixConfigs();
+JNIEXPORT jobjectArray JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_GetMatrixConfigs(JNIEnv* env, jobject thiz)
 {
-    const uint gx = gl_GlobalInvocationID.x;
-    const uint lx = gl_LocalInvocationID.x;
+    vkpeak_set_device_index(g_device_index);
 
-    fcoopmatNV<16, gl_ScopeSubgroup, M, K> a = fcoopmatNV<16, gl_ScopeSubgroup, M, K>(float(gx));
-    fcoopmatNV<16, gl_ScopeSubgroup, K, N> b = fcoopmatNV<16, gl_ScopeSubgroup, K, N>(float(lx));
+    const int config_count = vkpeak_get_matrix_config_count();
 
-    fcoopmatNV<32, gl_ScopeSubgroup, M, N> c0 = fcoopmatNV<32, gl_ScopeSubgroup, M, N>(float(gx));
-    fcoopmatNV<32, gl_ScopeSubgroup, M, N> c1 = fcoopmatNV<32, gl_ScopeSubgroup, M, N>(float(lx));
+    jobjectArray result = env->NewObjectArray(config_count, env->FindClass("java/lang/String"), 0);
 
-    for (int i = 0; i < loop; i++)
+    for (int i = 0; i < config_count; i++)
     {
-        c0 = coopMatMulAddNV(a, b, c0);
-        c1 = coopMatMulAddNV(a, b, c1);
-        c0 = coopMatMulAddNV(a, b, c0);
-        c1 = coopMatMulAddNV(a, b, c1);
-        c0 = coopMatMulAddNV(a, b, c0);
-        c1 = coopMatMulAddNV(a, b, c1);
-        c0 = coopMatMulAddNV(a, b, c0);
-        c1 = coopMatMulAddNV(a, b, c1);
-        c0 = coopMatMulAddNV(a, b, c0);
-        c1 = coopMatMulAddNV(a, b, c1);
-        c0 = coopMatMulAddNV(a, b, c0);
-        c1 = coopMatMulAddNV(a, b, c1);
-        c0 = coopMatMulAddNV(a, b, c0);
-        c1 = coopMatMulAddNV(a, b, c1);
-        c0 = coopMatMulAddNV(a, b, c0);
-        c1 = coopMatMulAddNV(a, b, c1);
-    }
-
-    c0 = c0 + c1;
-    coopMatStoreNV(c0, c_blob_data, gx * (M * N), N, false);
-}
-)";
+        vkpeak_matrix_config config;
+        vkpeak_get_matrix_config(i, &config);
 
-static const char glsl_fp16_fp32_matrix_khr_data[] = R"(
-#version 450
+        char desc[256];
+        sprintf(desc, "%dx%dx%d %s*%s+%s=%s%s", config.M, config.N, config.K, vkpeak_matrix_type_name(config.a_type), vkpeak_matrix_type_name(config.b_type),
+                vkpeak_matrix_type_name(config.c_type), vkpeak_matrix_type_name(config.result_type), config.saturating ? " sat" : "");
 
-#extension GL_EXT_shader_explicit_arithmetic_types_float16: require
-#extension GL_KHR_memory_scope_semantics: require
-#extension GL_EXT_shader_explicit_arithmetic_types: require
-#extension GL_KHR_cooperative_matrix: require
-
-layout (constant_id = 0) const int loop = 1;
-layout (constant_id = 1) const int M = 1;
-layout (constant_id = 2) const int N = 1;
-layout (constant_id = 3) const int K = 1;
-
-layout (binding = 0) writeonly buffer c_blob { float c_blob_data[]; };
-
-void main()
-{
-    const uint gx = gl_GlobalInvocationID.x;
-    const uint lx = gl_LocalInvocationID.x;
-
-    coopmat<float16_t, gl_ScopeSubgroup, M, K, gl_MatrixUseA> a = coopmat<float16_t, gl_ScopeSubgroup, M, K, gl_MatrixUseA>(float(gx));
-    coopmat<float16_t, gl_ScopeSubgroup, K, N, gl_MatrixUseB> b = coopmat<float16_t, gl_ScopeSubgroup, K, N, gl_MatrixUseB>(float(lx));
-
-    coopmat<float, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator> c = coopmat<float, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator>(float(gx));
-
-    for (int i = 0; i < loop; i++)
-    {
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
+        env->SetObjectArrayElement(result, i, env->NewStringUTF(desc));
     }
 
-    coopMatStore(c, c_blob_data, gx * (M * N), N, gl_CooperativeMatrixLayoutRowMajor);
+    return result;
 }
-)";
-
-static const char glsl_fp16_fp32_matrix_dual_khr_data[] = R"(
-#version 450
-
-#extension GL_EXT_shader_explicit_arithmetic_types_float16: require
-#extension GL_KHR_memory_scope_semantics: require
-#extension GL_EXT_shader_explicit_arithmetic_types: require
-#extension GL_KHR_cooperative_matrix: require
-
-layout (constant_id = 0) const int loop = 1;
-layout (constant_id = 1) const int M = 1;
-layout (constant_id = 2) const int N = 1;
-layout (constant_id = 3) const int K = 1;
 
-layout (binding = 0) writeonly buffer c_blob { float c_blob_data[]; };
-
-void main()
+// public native float RunMatrix(int loop, int count_mb, int cmd_loop, int config_index);
+JNIEXPORT jfloat JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_RunMatrix(JNIEnv* env, jobject thiz, jint loop, jint count_mb, jint cmd_loop, jint config_index)
 {
-    const uint gx = gl_GlobalInvocationID.x;
-    const uint lx = gl_LocalInvocationID.x;
-
-    coopmat<float16_t, gl_ScopeSubgroup, M, K, gl_MatrixUseA> a = coopmat<float16_t, gl_ScopeSubgroup, M, K, gl_MatrixUseA>(float(gx));
-    coopmat<float16_t, gl_ScopeSubgroup, K, N, gl_MatrixUseB> b = coopmat<float16_t, gl_ScopeSubgroup, K, N, gl_MatrixUseB>(float(lx));
-
-    coopmat<float, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator> c0 = coopmat<float, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator>(float(gx));
-    coopmat<float, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator> c1 = coopmat<float, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator>(float(lx));
+    vkpeak_set_device_index(g_device_index);
 
-    for (int i = 0; i < loop; i++)
-    {
-        c0 = coopMatMulAdd(a, b, c0);
-        c1 = coopMatMulAdd(a, b, c1);
-        c0 = coopMatMulAdd(a, b, c0);
-        c1 = coopMatMulAdd(a, b, c1);
-        c0 = coopMatMulAdd(a, b, c0);
-        c1 = coopMatMulAdd(a, b, c1);
-        c0 = coopMatMulAdd(a, b, c0);
-        c1 = coopMatMulAdd(a, b, c1);
-        c0 = coopMatMulAdd(a, b, c0);
-        c1 = coopMatMulAdd(a, b, c1);
-        c0 = coopMatMulAdd(a, b, c0);
-        c1 = coopMatMulAdd(a, b, c1);
-        c0 = coopMatMulAdd(a, b, c0);
-        c1 = coopMatMulAdd(a, b, c1);
-        c0 = coopMatMulAdd(a, b, c0);
-        c1 = coopMatMulAdd(a, b, c1);
-    }
+    double gops = vkpeak_matrix(loop, count_mb, cmd_loop, config_index);
 
-    c0 = c0 + c1;
-    coopMatStore(c0, c_blob_data, gx * (M * N), N, gl_CooperativeMatrixLayoutRowMajor);
+    return (jfloat)gops;
 }
-)";
-
-static const char glsl_int8_matrix_nv_data[] = R"(
-#version 450
-
-#extension GL_EXT_shader_explicit_arithmetic_types_int8: require
-#extension GL_KHR_memory_scope_semantics: require
-#extension GL_EXT_shader_explicit_arithmetic_types: require
-#extension GL_NV_cooperative_matrix: require
-#extension GL_NV_integer_cooperative_matrix : require
 
-layout (constant_id = 0) const int loop = 1;
-layout (constant_id = 1) const int M = 1;
-layout (constant_id = 2) const int N = 1;
-layout (constant_id = 3) const int K = 1;
-
-layout (binding = 0) writeonly buffer c_blob { int c_blob_data[]; };
-
-void main()
+// public native float RunMatrixBlocked(int loop, int count_mb, int cmd_loop, int config_index, int rows, int cols);
+JNIEXPORT jfloat JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_RunMatrixBlocked(JNIEnv* env, jobject thiz, jint loop, jint count_mb, jint cmd_loop, jint config_index, jint rows, jint cols)
 {
-    const uint gx = gl_GlobalInvocationID.x;
-    const uint lx = gl_LocalInvocationID.x;
-
-    icoopmatNV<8, gl_ScopeSubgroup, M, K> a = icoopmatNV<8, gl_ScopeSubgroup, M, K>(int8_t(gx));
-    icoopmatNV<8, gl_ScopeSubgroup, K, N> b = icoopmatNV<8, gl_ScopeSubgroup, K, N>(int8_t(lx));
+    vkpeak_set_device_index(g_device_index);
 
-    icoopmatNV<32, gl_ScopeSubgroup, M, N> c = icoopmatNV<32, gl_ScopeSubgroup, M, N>(int(gx));
+    double gops = vkpeak_matrix_blocked(loop, count_mb, cmd_loop, config_index, rows, cols);
 
-    for (int i = 0; i < loop; i++)
-    {
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-        c = coopMatMulAddNV(a, b, c);
-    }
-
-    coopMatStoreNV(c, c_blob_data, gx * (M * N), N, false);
+    return (jfloat)gops;
 }
-)";
-
-static const char glsl_int8_matrix_dual_nv_data[] = R"(
-#version 450
-
-#extension GL_EXT_shader_explicit_arithmetic_types_int8: require
-#extension GL_KHR_memory_scope_semantics: require
-#extension GL_EXT_shader_explicit_arithmetic_types: require
-#extension GL_NV_cooperative_matrix: require
-#extension GL_NV_integer_cooperative_matrix : require
-
-layout (constant_id = 0) const int loop = 1;
-layout (constant_id = 1) const int M = 1;
-layout (constant_id = 2) const int N = 1;
-layout (constant_id = 3) const int K = 1;
-
-layout (binding = 0) writeonly buffer c_blob { int c_blob_data[]; };
 
-void main()
+// public native float RunDot(int loop, int count_mb, int cmd_loop, int signedness_type, int saturating, int packing_type);
+JNIEXPORT jfloat JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_RunDot(JNIEnv* env, jobject thiz, jint loop, jint count_mb, jint cmd_loop, jint signedness_type, jint saturating, jint packing_type)
 {
-    const uint gx = gl_GlobalInvocationID.x;
-    const uint lx = gl_LocalInvocationID.x;
+    vkpeak_set_device_index(g_device_index);
 
-    icoopmatNV<8, gl_ScopeSubgroup, M, K> a = icoopmatNV<8, gl_ScopeSubgroup, M, K>(int8_t(gx));
-    icoopmatNV<8, gl_ScopeSubgroup, K, N> b = icoopmatNV<8, gl_ScopeSubgroup, K, N>(int8_t(lx));
+    double gops = vkpeak_dot(loop, count_mb, cmd_loop, signedness_type, saturating, packing_type);
 
-    icoopmatNV<32, gl_ScopeSubgroup, M, N> c0 = icoopmatNV<32, gl_ScopeSubgroup, M, N>(int(gx));
-    icoopmatNV<32, gl_ScopeSubgroup, M, N> c1 = icoopmatNV<32, gl_ScopeSubgroup, M, N>(int(lx));
-
-    for (int i = 0; i < loop; i++)
-    {
-        c0 = coopMatMulAddNV(a, b, c0);
-        c1 = coopMatMulAddNV(a, b, c1);
-        c0 = coopMatMulAddNV(a, b, c0);
-        c1 = coopMatMulAddNV(a, b, c1);
-        c0 = coopMatMulAddNV(a, b, c0);
-        c1 = coopMatMulAddNV(a, b, c1);
-        c0 = coopMatMulAddNV(a, b, c0);
-        c1 = coopMatMulAddNV(a, b, c1);
-        c0 = coopMatMulAddNV(a, b, c0);
-        c1 = coopMatMulAddNV(a, b, c1);
-        c0 = coopMatMulAddNV(a, b, c0);
-        c1 = coopMatMulAddNV(a, b, c1);
-        c0 = coopMatMulAddNV(a, b, c0);
-        c1 = coopMatMulAddNV(a, b, c1);
-        c0 = coopMatMulAddNV(a, b, c0);
-        c1 = coopMatMulAddNV(a, b, c1);
-    }
-
-    c0 = c0 + c1;
-    coopMatStoreNV(c0, c_blob_data, gx * (M * N), N, false);
+    return (jfloat)gops;
 }
-)";
-
-static const char glsl_int8_matrix_khr_data[] = R"(
-#version 450
-
-#extension GL_EXT_shader_explicit_arithmetic_types_float16: require
-#extension GL_KHR_memory_scope_semantics: require
-#extension GL_EXT_shader_explicit_arithmetic_types: require
-#extension GL_KHR_cooperative_matrix: require
-
-layout (constant_id = 0) const int loop = 1;
-layout (constant_id = 1) const int M = 1;
-layout (constant_id = 2) const int N = 1;
-layout (constant_id = 3) const int K = 1;
-
-layout (binding = 0) writeonly buffer c_blob { int c_blob_data[]; };
 
-void main()
+// public native boolean IsDotAccelerated(int signedness_type, int saturating);
+JNIEXPORT jboolean JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_IsDotAccelerated(JNIEnv* env, jobject thiz, jint signedness_type, jint saturating)
 {
-    const uint gx = gl_GlobalInvocationID.x;
-    const uint lx = gl_LocalInvocationID.x;
+    vkpeak_set_device_index(g_device_index);
 
-    coopmat<int8_t, gl_ScopeSubgroup, M, K, gl_MatrixUseA> a = coopmat<int8_t, gl_ScopeSubgroup, M, K, gl_MatrixUseA>(int8_t(gx));
-    coopmat<int8_t, gl_ScopeSubgroup, K, N, gl_MatrixUseB> b = coopmat<int8_t, gl_ScopeSubgroup, K, N, gl_MatrixUseB>(int8_t(lx));
-
-    coopmat<int, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator> c = coopmat<int, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator>(int(gx));
-
-    for (int i = 0; i < loop; i++)
-    {
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-    }
-
-    coopMatStore(c, c_blob_data, gx * (M * N), N, gl_CooperativeMatrixLayoutRowMajor);
+    return vkpeak_dot_accelerated(signedness_type, saturating) ? JNI_TRUE : JNI_FALSE;
 }
-)";
-
-static const char glsl_int8_matrix_dual_khr_data[] = R"(
-#version 450
-
-#extension GL_EXT_shader_explicit_arithmetic_types_float16: require
-#extension GL_KHR_memory_scope_semantics: require
-#extension GL_EXT_shader_explicit_arithmetic_types: require
-#extension GL_KHR_cooperative_matrix: require
 
-layout (constant_id = 0) const int loop = 1;
-layout (constant_id = 1) const int M = 1;
-layout (constant_id = 2) const int N = 1;
-layout (constant_id = 3) const int K = 1;
-
-layout (binding = 0) writeonly buffer c_blob { int c_blob_data[]; };
-
-void main()
+// public native float RunGemm(int cmd_loop, int gemm_type, int M, int N, int K);
+JNIEXPORT jfloat JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_RunGemm(JNIEnv* env, jobject thiz, jint cmd_loop, jint gemm_type, jint M, jint N, jint K)
 {
-    const uint gx = gl_GlobalInvocationID.x;
-    const uint lx = gl_LocalInvocationID.x;
+    vkpeak_set_device_index(g_device_index);
 
-    coopmat<int8_t, gl_ScopeSubgroup, M, K, gl_MatrixUseA> a = coopmat<int8_t, gl_ScopeSubgroup, M, K, gl_MatrixUseA>(int8_t(gx));
-    coopmat<int8_t, gl_ScopeSubgroup, K, N, gl_MatrixUseB> b = coopmat<int8_t, gl_ScopeSubgroup, K, N, gl_MatrixUseB>(int8_t(lx));
+    double gflops = vkpeak_gemm(cmd_loop, gemm_type, M, N, K);
 
-    coopmat<int, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator> c0 = coopmat<int, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator>(int(gx));
-    coopmat<int, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator> c1 = coopmat<int, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator>(int(lx));
-
-    for (int i = 0; i < loop; i++)
-    {
-        c0 = coopMatMulAdd(a, b, c0);
-        c1 = coopMatMulAdd(a, b, c1);
-        c0 = coopMatMulAdd(a, b, c0);
-        c1 = coopMatMulAdd(a, b, c1);
-        c0 = coopMatMulAdd(a, b, c0);
-        c1 = coopMatMulAdd(a, b, c1);
-        c0 = coopMatMulAdd(a, b, c0);
-        c1 = coopMatMulAdd(a, b, c1);
-        c0 = coopMatMulAdd(a, b, c0);
-        c1 = coopMatMulAdd(a, b, c1);
-        c0 = coopMatMulAdd(a, b, c0);
-        c1 = coopMatMulAdd(a, b, c1);
-        c0 = coopMatMulAdd(a, b, c0);
-        c1 = coopMatMulAdd(a, b, c1);
-        c0 = coopMatMulAdd(a, b, c0);
-        c1 = coopMatMulAdd(a, b, c1);
-    }
-
-    c0 = c0 + c1;
-    coopMatStore(c0, c_blob_data, gx * (M * N), N, gl_CooperativeMatrixLayoutRowMajor);
+    return (jfloat)gflops;
 }
-)";
 
-static const char glsl_bf16_matrix_khr_data[] = R"(
-#version 450
-
-#extension GL_EXT_shader_explicit_arithmetic_types_float16: require
-#extension GL_KHR_memory_scope_semantics: require
-#extension GL_EXT_shader_explicit_arithmetic_types: require
-#extension GL_KHR_cooperative_matrix: require
-#extension GL_EXT_bfloat16: require
-
-layout (constant_id = 0) const int loop = 1;
-layout (constant_id = 1) const int M = 1;
-layout (constant_id = 2) const int N = 1;
-layout (constant_id = 3) const int K = 1;
-
-layout (binding = 0) writeonly buffer c_blob { float c_blob_data[]; };
-
-void main()
+// public native float[] RunSweep(int loop, int count_mb, int cmd_loop, int[] configs);
+JNIEXPORT jfloatArray JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_RunSweep(JNIEnv* env, jobject thiz, jint loop, jint count_mb, jint cmd_loop, jintArray configs)
 {
-    const uint gx = gl_GlobalInvocationID.x;
-    const uint lx = gl_LocalInvocationID.x;
+    vkpeak_set_device_index(g_device_index);
 
-    coopmat<bfloat16_t, gl_ScopeSubgroup, M, K, gl_MatrixUseA> a = coopmat<bfloat16_t, gl_ScopeSubgroup, M, K, gl_MatrixUseA>(float(gx));
-    coopmat<bfloat16_t, gl_ScopeSubgroup, K, N, gl_MatrixUseB> b = coopmat<bfloat16_t, gl_ScopeSubgroup, K, N, gl_MatrixUseB>(float(lx));
+    const int config_count = env->GetArrayLength(configs) / 3;
 
-    coopmat<bfloat16_t, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator> c = coopmat<bfloat16_t, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator>(float(gx));
+    std::vector<jint> config_data(config_count * 3);
+    env->GetIntArrayRegion(configs, 0, config_count * 3, config_data.data());
 
-    for (int i = 0; i < loop; i++)
+    std::vector<int> storage_types(config_count);
+    std::vector<int> arithmetic_types(config_count);
+    std::vector<int> packing_types(config_count);
+    for (int i = 0; i < config_count; i++)
     {
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
+        storage_types[i] = config_data[i * 3];
+        arithmetic_types[i] = config_data[i * 3 + 1];
+        packing_types[i] = config_data[i * 3 + 2];
     }
 
-    coopMatStore(c, c_blob_data, gx * (M * N) / 2, N / 2, gl_CooperativeMatrixLayoutRowMajor);
-}
-)";
-
-static const char glsl_bf16_matrix_dual_khr_data[] = R"(
-#version 450
-
-#extension GL_EXT_shader_explicit_arithmetic_types_float16: require
-#extension GL_KHR_memory_scope_semantics: require
-#extension GL_EXT_shader_explicit_arithmetic_types: require
-#extension GL_KHR_cooperative_matrix: require
-#extension GL_EXT_bfloat16: require
+    std::vector<double> results(config_count);
+    std::vector<vkpeak_stats> stats(config_count);
+    vkpeak_sweep(loop, count_mb, cmd_loop, config_count, storage_types.data(), arithmetic_types.data(), packing_types.data(), results.data(), stats.data());
 
-layout (constant_id = 0) const int loop = 1;
-layout (constant_id = 1) const int M = 1;
-layout (constant_id = 2) const int N = 1;
-layout (constant_id = 3) const int K = 1;
-
-layout (binding = 0) writeonly buffer c_blob { float c_blob_data[]; };
-
-void main()
-{
-    const uint gx = gl_GlobalInvocationID.x;
-    const uint lx = gl_LocalInvocationID.x;
-
-    coopmat<bfloat16_t, gl_ScopeSubgroup, M, K, gl_MatrixUseA> a = coopmat<bfloat16_t, gl_ScopeSubgroup, M, K, gl_MatrixUseA>(float(gx));
-    coopmat<bfloat16_t, gl_ScopeSubgroup, K, N, gl_MatrixUseB> b = coopmat<bfloat16_t, gl_ScopeSubgroup, K, N, gl_MatrixUseB>(float(lx));
-
-    coopmat<bfloat16_t, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator> c0 = coopmat<bfloat16_t, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator>(float(gx));
-    coopmat<bfloat16_t, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator> c1 = coopmat<bfloat16_t, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator>(float(lx));
-
-    for (int i = 0; i < loop; i++)
+    std::vector<jfloat> values(config_count * 7);
+    for (int i = 0; i < config_count; i++)
     {
-        c0 = coopMatMulAdd(a, b, c0);
-        c1 = coopMatMulAdd(a, b, c1);
-        c0 = coopMatMulAdd(a, b, c0);
-        c1 = coopMatMulAdd(a, b, c1);
-        c0 = coopMatMulAdd(a, b, c0);
-        c1 = coopMatMulAdd(a, b, c1);
-        c0 = coopMatMulAdd(a, b, c0);
-        c1 = coopMatMulAdd(a, b, c1);
-        c0 = coopMatMulAdd(a, b, c0);
-        c1 = coopMatMulAdd(a, b, c1);
-        c0 = coopMatMulAdd(a, b, c0);
-        c1 = coopMatMulAdd(a, b, c1);
-        c0 = coopMatMulAdd(a, b, c0);
-        c1 = coopMatMulAdd(a, b, c1);
-        c0 = coopMatMulAdd(a, b, c0);
-        c1 = coopMatMulAdd(a, b, c1);
+        jfloat* v = &values[i * 7];
+        v[0] = (jfloat)results[i];
+        v[1] = (jfloat)stats[i].median;
+        v[2] = (jfloat)stats[i].p10;
+        v[3] = (jfloat)stats[i].p90;
+        v[4] = (jfloat)stats[i].max;
+        v[5] = (jfloat)stats[i].cv;
+        v[6] = (jfloat)stats[i].sample_count;
     }
 
-    coopmat<float, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator> c2 = coopmat<float, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator>(c0);
-    coopmat<float, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator> c3 = coopmat<float, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator>(c1);
+    jfloatArray result = env->NewFloatArray(config_count * 7);
+    env->SetFloatArrayRegion(result, 0, config_count * 7, values.data());
 
-    c0 = coopmat<bfloat16_t, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator>(c2 + c3);
-    coopMatStore(c0, c_blob_data, gx * (M * N) / 2, N / 2, gl_CooperativeMatrixLayoutRowMajor);
+    return result;
 }
-)";
-
-static const char glsl_bf16_fp32_matrix_khr_data[] = R"(
-#version 450
 
-#extension GL_EXT_shader_explicit_arithmetic_types_float16: require
-#extension GL_KHR_memory_scope_semantics: require
-#extension GL_EXT_shader_explicit_arithmetic_types: require
-#extension GL_KHR_cooperative_matrix: require
-#extension GL_EXT_bfloat16: require
-
-layout (constant_id = 0) const int loop = 1;
-layout (constant_id = 1) const int M = 1;
-layout (constant_id = 2) const int N = 1;
-layout (constant_id = 3) const int K = 1;
-
-layout (binding = 0) writeonly buffer c_blob { float c_blob_data[]; };
-
-void main()
+// public native float RunBandwidth(int loop, int count_mb, int cmd_loop, int storage_type, int access_type, int packing_type);
+JNIEXPORT jfloat JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_RunBandwidth(JNIEnv* env, jobject thiz, jint loop, jint count_mb, jint cmd_loop, jint storage_type, jint access_type, jint packing_type)
 {
-    const uint gx = gl_GlobalInvocationID.x;
-    const uint lx = gl_LocalInvocationID.x;
-
-    coopmat<bfloat16_t, gl_ScopeSubgroup, M, K, gl_MatrixUseA> a = coopmat<bfloat16_t, gl_ScopeSubgroup, M, K, gl_MatrixUseA>(float(gx));
-    coopmat<bfloat16_t, gl_ScopeSubgroup, K, N, gl_MatrixUseB> b = coopmat<bfloat16_t, gl_ScopeSubgroup, K, N, gl_MatrixUseB>(float(lx));
+    vkpeak_set_device_index(g_device_index);
 
-    coopmat<float, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator> c = coopmat<float, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator>(float(gx));
-
-    for (int i = 0; i < loop; i++)
-    {
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-        c = coopMatMulAdd(a, b, c);
-    }
+    double gbps = vkpeak_bandwidth(loop, count_mb, cmd_loop, storage_type, access_type, packing_type);
 
-    coopMatStore(c, c_blob_data, gx * (M * N), N, gl_CooperativeMatrixLayoutRowMajor);
+    return (jfloat)gbps;
 }
-)";
 
-static const char glsl_bf16_fp32_matrix_dual_khr_data[] = R"(
-#version 450
-
-#extension GL_EXT_shader_explicit_arithmetic_types_float16: require
-#extension GL_KHR_memory_scope_semantics: require
-#extension GL_EXT_shader_explicit_arithmetic_types: require
-#extension GL_KHR_cooperative_matrix: require
-#extension GL_EXT_bfloat16: require
-
-layout (constant_id = 0) const int loop = 1;
-layout (constant_id = 1) const int M = 1;
-layout (constant_id = 2) const int N = 1;
-layout (constant_id = 3) const int K = 1;
-
-layout (binding = 0) writeonly buffer c_blob { float c_blob_data[]; };
-
-void main()
+// public native float RunShared(int loop, int count_mb, int cmd_loop, int access_type, int stride);
+JNIEXPORT jfloat JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_RunShared(JNIEnv* env, jobject thiz, jint loop, jint count_mb, jint cmd_loop, jint access_type, jint stride)
 {
-    const uint gx = gl_GlobalInvocationID.x;
-    const uint lx = gl_LocalInvocationID.x;
+    vkpeak_set_device_index(g_device_index);
 
-    coopmat<bfloat16_t, gl_ScopeSubgroup, M, K, gl_MatrixUseA> a = coopmat<bfloat16_t, gl_ScopeSubgroup, M, K, gl_MatrixUseA>(float(gx));
-    coopmat<bfloat16_t, gl_ScopeSubgroup, K, N, gl_MatrixUseB> b = coopmat<bfloat16_t, gl_ScopeSubgroup, K, N, gl_MatrixUseB>(float(lx));
-
-    coopmat<float, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator> c0 = coopmat<float, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator>(float(gx));
-    coopmat<float, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator> c1 = coopmat<float, gl_ScopeSubgroup, M, N, gl_MatrixUseAccumulator>(float(lx));
-
-    for (int i = 0; i < loop; i++)
-    {
-        c0 = coopMatMulAdd(a, b, c0);
-        c1 = coopMatMulAdd(a, b, c1);
-        c0 = coopMatMulAdd(a, b, c0);
-        c1 = coopMatMulAdd(a, b, c1);
-        c0 = coopMatMulAdd(a, b, c0);
-        c1 = coopMatMulAdd(a, b, c1);
-        c0 = coopMatMulAdd(a, b, c0);
-        c1 = coopMatMulAdd(a, b, c1);
-        c0 = coopMatMulAdd(a, b, c0);
-        c1 = coopMatMulAdd(a, b, c1);
-        c0 = coopMatMulAdd(a, b, c0);
-        c1 = coopMatMulAdd(a, b, c1);
-        c0 = coopMatMulAdd(a, b, c0);
-        c1 = coopMatMulAdd(a, b, c1);
-        c0 = coopMatMulAdd(a, b, c0);
-        c1 = coopMatMulAdd(a, b, c1);
-    }
+    double gbps = vkpeak_shared(loop, count_mb, cmd_loop, access_type, stride);
 
-    c0 = c0 + c1;
-    coopMatStore(c0, c_blob_data, gx * (M * N), N, gl_CooperativeMatrixLayoutRowMajor);
+    return (jfloat)gbps;
 }
-)";
 
-static double vkpeak(int loop, int count_mb, int cmd_loop, int storage_type, int arithmetic_type, int packing_type)
+// public native float RunSubgroup(int loop, int count_mb, int cmd_loop, int arithmetic_type, int op_type);
+JNIEXPORT jfloat JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_RunSubgroup(JNIEnv* env, jobject thiz, jint loop, jint count_mb, jint cmd_loop, jint arithmetic_type, jint op_type)
 {
-    ncnn::VulkanDevice* vkdev = ncnn::get_gpu_device();
+    vkpeak_set_device_index(g_device_index);
 
-    if (!vkdev)
-    {
-        return 0;
-    }
+    double gops = vkpeak_subgroup(loop, count_mb, cmd_loop, arithmetic_type, op_type);
 
-    if (!vkdev->info.support_fp16_storage() && storage_type == 1)
-    {
-        return 0;
-    }
-    if (!vkdev->info.support_fp16_storage() && storage_type == 4)
-    {
-        return 0;
-    }
-    if (!vkdev->info.support_fp16_arithmetic() && arithmetic_type == 1)
-    {
-        return 0;
-    }
-    if (!vkdev->info.support_fp16_arithmetic() && arithmetic_type == 4)
-    {
-        return 0;
-    }
-    if (!vkdev->info.support_int8_arithmetic() && arithmetic_type == 5)
-    {
-        return 0;
-    }
-    if (!vkdev->info.support_cooperative_matrix() && packing_type == 256)
-    {
-        return 0;
-    }
-
-    // check shader fp64 feature
-    bool has_shader_fp64 = vkdev->info.physicalDevicefeatures().shaderFloat64;
-    if (!has_shader_fp64 && (storage_type == 2 || arithmetic_type == 2))
-    {
-        return 0;
-    }
-
-    // check shader int8 dotprod feature
-    bool has_shader_int8_dotprod = vkdev->info.queryShaderIntegerDotProductFeatures().shaderIntegerDotProduct;
-    if (!has_shader_int8_dotprod && (arithmetic_type == 5 && packing_type == 4))
-    {
-        return 0;
-    }
-
-    // check shader bf16 feature
-    bool has_shader_bf16 = vkdev->info.queryShaderBfloat16Features().shaderBFloat16Type;
-    if (!has_shader_bf16 && (arithmetic_type == 6))
-    {
-        return 0;
-    }
-
-    // check shader bf16 dotprod feature
-    bool has_shader_bf16_dotprod = vkdev->info.queryShaderBfloat16Features().shaderBFloat16DotProduct;
-    if (!has_shader_bf16_dotprod && (arithmetic_type == 6 && packing_type == 4))
-    {
-        return 0;
-    }
-
-    // check shader bf16 cooperative matrix feature
-    bool has_shader_bf16_matrix = vkdev->info.queryShaderBfloat16Features().shaderBFloat16CooperativeMatrix;
-    if (!has_shader_bf16_matrix && (arithmetic_type == 6 && packing_type == 256))
-    {
-        return 0;
-    }
-
-    ncnn::Option opt;
-    opt.use_vulkan_compute = true;
-    opt.use_fp16_packed = storage_type == 1;
-    opt.use_fp16_storage = storage_type == 1 || storage_type == 4;
-    opt.use_fp16_arithmetic = arithmetic_type == 1;
-
-    ncnn::VkAllocator* allocator = vkdev->acquire_blob_allocator();
-
-    // reuse c storage, max 512M
-    int buffer_size = std::min((int)(vkdev->get_heap_budget() / 8), 512) * 1024 * 1024;
-    if (vkdev->info.type() == 1)
-    {
-        // max 128M for integrated gpu
-        buffer_size = std::min(buffer_size, 128 * 1024 * 1024);
-    }
-
-    buffer_size = std::min(buffer_size, count_mb * 1024 * 1024);
-
-    ncnn::VkMat c(buffer_size, (size_t)1u, 1, allocator);
-
-    int elemsize;
-    if (storage_type == 0 || storage_type == 3)
-    {
-        // fp32 / int32
-        elemsize = 4;
-    }
-    else if (storage_type == 1 || storage_type == 4)
-    {
-        // fp16 / int16
-        elemsize = 2;
-    }
-    else if (storage_type == 2)
-    {
-        // fp64
-        elemsize = 8;
-    }
-    else if (storage_type == 5)
-    {
-        // int8
-        elemsize = 1;
-    }
-
-    int local_size_x = std::min(128, std::max(1, (int)vkdev->info.subgroup_size()));
-    if (packing_type == 256)
-    {
-        // matrix on subgroup
-        local_size_x = (int)vkdev->info.subgroup_size();
-    }
-
-    int M = 1;
-    int N = 1;
-    int K = 1;
-    bool use_fp16_fp32_matrix = false;
-    bool use_bf16_fp32_matrix = false;
-    if (packing_type == 256)
-    {
-        bool mnk_found = false;
-
-        if (arithmetic_type == 1)
-        {
-            if (vkdev->info.support_VK_KHR_cooperative_matrix())
-            {
-                const std::vector<VkCooperativeMatrixPropertiesKHR>& properties = vkdev->info.queryCooperativeMatrixProperties();
-
-                {
-                    // find fp16 * fp16 => fp16
-                    for (uint32_t j = 0; j < properties.size(); j++)
-                    {
-                        const VkCooperativeMatrixPropertiesKHR& cmp = properties[j];
-
-                        if (cmp.AType == VK_COMPONENT_TYPE_FLOAT16_KHR && cmp.BType == VK_COMPONENT_TYPE_FLOAT16_KHR
-                            && cmp.CType == VK_COMPONENT_TYPE_FLOAT16_KHR && cmp.ResultType == VK_COMPONENT_TYPE_FLOAT16_KHR
-                            && cmp.scope == VK_SCOPE_SUBGROUP_KHR)
-                        {
-                            M = cmp.MSize;
-                            N = cmp.NSize;
-                            K = cmp.KSize;
-                            mnk_found = true;
-                            break;
-                        }
-                    }
-                }
-
-                if (!mnk_found)
-                {
-                    // find fp16 * fp16 => fp32
-                    for (uint32_t j = 0; j < properties.size(); j++)
-                    {
-                        const VkCooperativeMatrixPropertiesKHR& cmp = properties[j];
-
-                        if (cmp.AType == VK_COMPONENT_TYPE_FLOAT16_KHR && cmp.BType == VK_COMPONENT_TYPE_FLOAT16_KHR
-                            && cmp.CType == VK_COMPONENT_TYPE_FLOAT32_KHR && cmp.ResultType == VK_COMPONENT_TYPE_FLOAT32_KHR
-                            && cmp.scope == VK_SCOPE_SUBGROUP_KHR)
-                        {
-                            M = cmp.MSize;
-                            N = cmp.NSize;
-                            K = cmp.KSize;
-                            mnk_found = true;
-                            use_fp16_fp32_matrix = true;
-                            break;
-                        }
-                    }
-                }
-            }
-            else // if (vkdev->info.support_VK_NV_cooperative_matrix())
-            {
-                const std::vector<VkCooperativeMatrixPropertiesNV>& properties = vkdev->info.queryCooperativeMatrixPropertiesNV();
-
-                {
-                    // find fp16 * fp16 => fp16
-                    for (uint32_t j = 0; j < properties.size(); j++)
-                    {
-                        const VkCooperativeMatrixPropertiesNV& cmp = properties[j];
-
-                        if (cmp.AType == VK_COMPONENT_TYPE_FLOAT16_NV && cmp.BType == VK_COMPONENT_TYPE_FLOAT16_NV
-                            && cmp.CType == VK_COMPONENT_TYPE_FLOAT16_NV && cmp.DType == VK_COMPONENT_TYPE_FLOAT16_NV
-                            && cmp.scope == VK_SCOPE_SUBGROUP_NV)
-                        {
-                            M = cmp.MSize;
-                            N = cmp.NSize;
-                            K = cmp.KSize;
-                            mnk_found = true;
-                            break;
-                        }
-                    }
-                }
-
-                if (!mnk_found)
-                {
-                    // find fp16 * fp16 => fp32
-                    for (uint32_t j = 0; j < properties.size(); j++)
-                    {
-                        const VkCooperativeMatrixPropertiesNV& cmp = properties[j];
-
-                        if (cmp.AType == VK_COMPONENT_TYPE_FLOAT16_NV && cmp.BType == VK_COMPONENT_TYPE_FLOAT16_NV
-                            && cmp.CType == VK_COMPONENT_TYPE_FLOAT32_NV && cmp.DType == VK_COMPONENT_TYPE_FLOAT32_NV
-                            && cmp.scope == VK_SCOPE_SUBGROUP_NV)
-                        {
-                            M = cmp.MSize;
-                            N = cmp.NSize;
-                            K = cmp.KSize;
-                            mnk_found = true;
-                            use_fp16_fp32_matrix = true;
-                            break;
-                        }
-                    }
-                }
-            }
-        }
-
-        if (arithmetic_type == 5)
-        {
-            if (vkdev->info.support_VK_KHR_cooperative_matrix())
-            {
-                const std::vector<VkCooperativeMatrixPropertiesKHR>& properties = vkdev->info.queryCooperativeMatrixProperties();
-
-                // find int8 * int8 => int32
-                for (uint32_t j = 0; j < properties.size(); j++)
-                {
-                    const VkCooperativeMatrixPropertiesKHR& cmp = properties[j];
-
-                    if (cmp.AType == VK_COMPONENT_TYPE_SINT8_KHR && cmp.BType == VK_COMPONENT_TYPE_SINT8_KHR
-                        && cmp.CType == VK_COMPONENT_TYPE_SINT32_KHR && cmp.ResultType == VK_COMPONENT_TYPE_SINT32_KHR
-                        && cmp.scope == VK_SCOPE_SUBGROUP_KHR)
-                    {
-                        M = cmp.MSize;
-                        N = cmp.NSize;
-                        K = cmp.KSize;
-                        mnk_found = true;
-                        break;
-                    }
-                }
-            }
-            else // if (vkdev->info.support_VK_NV_cooperative_matrix())
-            {
-                const std::vector<VkCooperativeMatrixPropertiesNV>& properties = vkdev->info.queryCooperativeMatrixPropertiesNV();
-
-                // find int8 * int8 => int32
-                for (uint32_t j = 0; j < properties.size(); j++)
-                {
-                    const VkCooperativeMatrixPropertiesNV& cmp = properties[j];
-
-                    if (cmp.AType == VK_COMPONENT_TYPE_SINT8_NV && cmp.BType == VK_COMPONENT_TYPE_SINT8_NV
-                        && cmp.CType == VK_COMPONENT_TYPE_SINT32_NV && cmp.DType == VK_COMPONENT_TYPE_SINT32_NV
-                        && cmp.scope == VK_SCOPE_SUBGROUP_NV)
-                    {
-                        M = cmp.MSize;
-                        N = cmp.NSize;
-                        K = cmp.KSize;
-                        mnk_found = true;
-                        break;
-                    }
-                }
-            }
-        }
-
-        if (arithmetic_type == 6)
-        {
-            if (vkdev->info.support_VK_KHR_cooperative_matrix())
-            {
-                const std::vector<VkCooperativeMatrixPropertiesKHR>& properties = vkdev->info.queryCooperativeMatrixProperties();
-
-                {
-                    // find bf16 * bf16 => bf16
-                    for (uint32_t j = 0; j < properties.size(); j++)
-                    {
-                        const VkCooperativeMatrixPropertiesKHR& cmp = properties[j];
-
-                        if (cmp.AType == VK_COMPONENT_TYPE_BFLOAT16_KHR && cmp.BType == VK_COMPONENT_TYPE_BFLOAT16_KHR
-                            && cmp.CType == VK_COMPONENT_TYPE_BFLOAT16_KHR && cmp.ResultType == VK_COMPONENT_TYPE_BFLOAT16_KHR
-                            && cmp.scope == VK_SCOPE_SUBGROUP_KHR)
-                        {
-                            M = cmp.MSize;
-                            N = cmp.NSize;
-                            K = cmp.KSize;
-                            mnk_found = true;
-                            break;
-                        }
-                    }
-                }
-
-                if (!mnk_found)
-                {
-                    // find bf16 * bf16 => fp32
-                    for (uint32_t j = 0; j < properties.size(); j++)
-                    {
-                        const VkCooperativeMatrixPropertiesKHR& cmp = properties[j];
-
-                        if (cmp.AType == VK_COMPONENT_TYPE_BFLOAT16_KHR && cmp.BType == VK_COMPONENT_TYPE_BFLOAT16_KHR
-                            && cmp.CType == VK_COMPONENT_TYPE_FLOAT32_KHR && cmp.ResultType == VK_COMPONENT_TYPE_FLOAT32_KHR
-                            && cmp.scope == VK_SCOPE_SUBGROUP_KHR)
-                        {
-                            M = cmp.MSize;
-                            N = cmp.NSize;
-                            K = cmp.KSize;
-                            mnk_found = true;
-                            use_bf16_fp32_matrix = true;
-                            break;
-                        }
-                    }
-                }
-            }
-        }
-
-        if (!mnk_found)
-        {
-            // no supported component type
-            return 0;
-        }
-    }
-
-    int max_invocation_count = buffer_size / elemsize;
-    // make max_invocation_count be multiple of local_size_x
-    max_invocation_count = std::max(max_invocation_count / local_size_x, 1) * local_size_x;
-    if (packing_type == 256)
-    {
-        if (use_fp16_fp32_matrix || use_bf16_fp32_matrix)
-            max_invocation_count = std::max(max_invocation_count / (M * N) / 2, 1);
-        else
-            max_invocation_count = std::max(max_invocation_count / (M * N), 1);
-    }
-
-    double max_gflops = 0;
-
-    // start with little works
-    int invocation_count = std::max(max_invocation_count / 32, 8);
-
-    bool rerun = true;
-
-    // prepare storage
-    while (rerun)
-    {
-        rerun = false;
-
-        // setup pipeline
-        ncnn::Pipeline pipeline(vkdev);
-        ncnn::Pipeline pipeline_dual(vkdev);
-        {
-            pipeline.set_local_size_xyz(local_size_x, 1, 1);
-            pipeline_dual.set_local_size_xyz(local_size_x, 1, 1);
-
-            std::vector<ncnn::vk_specialization_type> specializations(1);
-            specializations[0].i = loop;
-
-            // glsl to spirv
-            // -1 for omit the tail '\0'
-            std::vector<uint32_t> spirv;
-            std::vector<uint32_t> spirv_dual;
-            if (arithmetic_type == 2)
-            {
-                if (packing_type == 1)
-                {
-                    ncnn::compile_spirv_module(glsl_fp64_p1_data, sizeof(glsl_fp64_p1_data) - 1, opt, spirv);
-                    ncnn::compile_spirv_module(glsl_fp64_p1_dual_data, sizeof(glsl_fp64_p1_dual_data) - 1, opt, spirv_dual);
-                }
-                if (packing_type == 4)
-                {
-                    ncnn::compile_spirv_module(glsl_fp64_p4_data, sizeof(glsl_fp64_p4_data) - 1, opt, spirv);
-                    ncnn::compile_spirv_module(glsl_fp64_p4_dual_data, sizeof(glsl_fp64_p4_dual_data) - 1, opt, spirv_dual);
-                }
-            }
-            else if (arithmetic_type == 3)
-            {
-                if (packing_type == 1)
-                {
-                    ncnn::compile_spirv_module(glsl_int32_p1_data, sizeof(glsl_int32_p1_data) - 1, opt, spirv);
-                    ncnn::compile_spirv_module(glsl_int32_p1_dual_data, sizeof(glsl_int32_p1_dual_data) - 1, opt, spirv_dual);
-                }
-                if (packing_type == 4)
-                {
-                    ncnn::compile_spirv_module(glsl_int32_p4_data, sizeof(glsl_int32_p4_data) - 1, opt, spirv);
-                    ncnn::compile_spirv_module(glsl_int32_p4_dual_data, sizeof(glsl_int32_p4_dual_data) - 1, opt, spirv_dual);
-                }
-            }
-            else if (arithmetic_type == 4)
-            {
-                if (packing_type == 1)
-                {
-                    ncnn::compile_spirv_module(glsl_int16_p1_data, sizeof(glsl_int16_p1_data) - 1, opt, spirv);
-                    ncnn::compile_spirv_module(glsl_int16_p1_dual_data, sizeof(glsl_int16_p1_dual_data) - 1, opt, spirv_dual);
-                }
-                if (packing_type == 4)
-                {
-                    ncnn::compile_spirv_module(glsl_int16_p4_data, sizeof(glsl_int16_p4_data) - 1, opt, spirv);
-                    ncnn::compile_spirv_module(glsl_int16_p4_dual_data, sizeof(glsl_int16_p4_dual_data) - 1, opt, spirv_dual);
-                }
-            }
-            else if (arithmetic_type == 5)
-            {
-                if (packing_type == 4)
-                {
-                    ncnn::compile_spirv_module(glsl_int8_p4_data, sizeof(glsl_int8_p4_data) - 1, opt, spirv);
-                    ncnn::compile_spirv_module(glsl_int8_p4_dual_data, sizeof(glsl_int8_p4_dual_data) - 1, opt, spirv_dual);
-                }
-                if (packing_type == 256)
-                {
-                    // loop M N K
-                    specializations.resize(4);
-                    specializations[1].i = M;
-                    specializations[2].i = N;
-                    specializations[3].i = K;
-
-                    if (vkdev->info.support_VK_KHR_cooperative_matrix())
-                    {
-                        ncnn::compile_spirv_module(glsl_int8_matrix_khr_data, sizeof(glsl_int8_matrix_khr_data) - 1, opt, spirv);
-                        ncnn::compile_spirv_module(glsl_int8_matrix_dual_khr_data, sizeof(glsl_int8_matrix_dual_khr_data) - 1, opt, spirv_dual);
-                    }
-                    else
-                    {
-                        ncnn::compile_spirv_module(glsl_int8_matrix_nv_data, sizeof(glsl_int8_matrix_nv_data) - 1, opt, spirv);
-                        ncnn::compile_spirv_module(glsl_int8_matrix_dual_nv_data, sizeof(glsl_int8_matrix_dual_nv_data) - 1, opt, spirv_dual);
-                    }
-                }
-            }
-            else if (arithmetic_type == 6)
-            {
-                if (packing_type == 4)
-                {
-                    ncnn::compile_spirv_module(glsl_bf16_p4_data, sizeof(glsl_bf16_p4_data) - 1, opt, spirv);
-                    ncnn::compile_spirv_module(glsl_bf16_p4_dual_data, sizeof(glsl_bf16_p4_dual_data) - 1, opt, spirv_dual);
-                }
-                if (packing_type == 256)
-                {
-                    // loop M N K
-                    specializations.resize(4);
-                    specializations[1].i = M;
-                    specializations[2].i = N;
-                    specializations[3].i = K;
-
-                    if (use_bf16_fp32_matrix)
-                    {
-                        ncnn::compile_spirv_module(glsl_bf16_fp32_matrix_khr_data, sizeof(glsl_bf16_fp32_matrix_khr_data) - 1, opt, spirv);
-                        ncnn::compile_spirv_module(glsl_bf16_fp32_matrix_dual_khr_data, sizeof(glsl_bf16_fp32_matrix_dual_khr_data) - 1, opt, spirv_dual);
-                    }
-                    else
-                    {
-                        ncnn::compile_spirv_module(glsl_bf16_matrix_khr_data, sizeof(glsl_bf16_matrix_khr_data) - 1, opt, spirv);
-                        ncnn::compile_spirv_module(glsl_bf16_matrix_dual_khr_data, sizeof(glsl_bf16_matrix_dual_khr_data) - 1, opt, spirv_dual);
-                    }
-                }
-            }
-            else // if (arithmetic_type == 0 || arithmetic_type == 1)
-            {
-                if (packing_type == 1)
-                {
-                    ncnn::compile_spirv_module(glsl_p1_data, sizeof(glsl_p1_data) - 1, opt, spirv);
-                    ncnn::compile_spirv_module(glsl_p1_dual_data, sizeof(glsl_p1_dual_data) - 1, opt, spirv_dual);
-                }
-                if (packing_type == 4)
-                {
-                    ncnn::compile_spirv_module(glsl_p4_data, sizeof(glsl_p4_data) - 1, opt, spirv);
-                    ncnn::compile_spirv_module(glsl_p4_dual_data, sizeof(glsl_p4_dual_data) - 1, opt, spirv_dual);
-                }
-                if (packing_type == 256)
-                {
-                    // loop M N K
-                    specializations.resize(4);
-                    specializations[1].i = M;
-                    specializations[2].i = N;
-                    specializations[3].i = K;
-
-                    if (vkdev->info.support_VK_KHR_cooperative_matrix())
-                    {
-                        if (use_fp16_fp32_matrix)
-                        {
-                            ncnn::compile_spirv_module(glsl_fp16_fp32_matrix_khr_data, sizeof(glsl_fp16_fp32_matrix_khr_data) - 1, opt, spirv);
-                            ncnn::compile_spirv_module(glsl_fp16_fp32_matrix_dual_khr_data, sizeof(glsl_fp16_fp32_matrix_dual_khr_data) - 1, opt, spirv_dual);
-                        }
-                        else
-                        {
-                            ncnn::compile_spirv_module(glsl_fp16_matrix_khr_data, sizeof(glsl_fp16_matrix_khr_data) - 1, opt, spirv);
-                            ncnn::compile_spirv_module(glsl_fp16_matrix_dual_khr_data, sizeof(glsl_fp16_matrix_dual_khr_data) - 1, opt, spirv_dual);
-                        }
-                    }
-                    else
-                    {
-                        if (use_fp16_fp32_matrix)
-                        {
-                            ncnn::compile_spirv_module(glsl_fp16_fp32_matrix_nv_data, sizeof(glsl_fp16_fp32_matrix_nv_data) - 1, opt, spirv);
-                            ncnn::compile_spirv_module(glsl_fp16_fp32_matrix_dual_nv_data, sizeof(glsl_fp16_fp32_matrix_dual_nv_data) - 1, opt, spirv_dual);
-                        }
-                        else
-                        {
-                            ncnn::compile_spirv_module(glsl_fp16_matrix_nv_data, sizeof(glsl_fp16_matrix_nv_data) - 1, opt, spirv);
-                            ncnn::compile_spirv_module(glsl_fp16_matrix_dual_nv_data, sizeof(glsl_fp16_matrix_dual_nv_data) - 1, opt, spirv_dual);
-                        }
-                    }
-                }
-            }
-
-            int ret0 = pipeline.create(spirv.data(), spirv.size() * 4, specializations);
-            int ret1 = pipeline_dual.create(spirv_dual.data(), spirv_dual.size() * 4, specializations);
-            if (ret0 != 0 || ret1 != 0)
-            {
-                vkdev->reclaim_blob_allocator(allocator);
-                return 0;
-            }
-        }
-
-        for (int i = 0; i < cmd_loop; i++)
-        {
-            // encode command
-            ncnn::VkCompute cmd(vkdev);
-            ncnn::VkCompute cmd_dual(vkdev);
-            {
-                std::vector<ncnn::VkMat> bindings(1);
-                bindings[0] = c;
-
-                std::vector<ncnn::vk_constant_type> constants(0);
-
-                ncnn::VkMat dispatcher;
-                dispatcher.w = invocation_count;
-                dispatcher.h = 1;
-                dispatcher.c = 1;
-                cmd.record_pipeline(&pipeline, bindings, constants, dispatcher);
-                cmd_dual.record_pipeline(&pipeline_dual, bindings, constants, dispatcher);
-            }
-
-            // time this
-            {
-                double t0 = ncnn::get_current_time();
-
-                int ret = cmd.submit_and_wait();
-                if (ret != 0)
-                {
-                    vkdev->reclaim_blob_allocator(allocator);
-                    return 0;
-                }
-
-                double t1 = ncnn::get_current_time();
-
-                ret = cmd_dual.submit_and_wait();
-                if (ret != 0)
-                {
-                    vkdev->reclaim_blob_allocator(allocator);
-                    return 0;
-                }
-
-                double t2 = ncnn::get_current_time();
-
-                double time = t1 - t0;
-                double time_dual = t2 - t1;
-
-                if (time < 800 || time_dual < 800)
-                {
-                    // for fast device
-                    if (invocation_count * 2 <= max_invocation_count)
-                    {
-                        invocation_count = std::min(invocation_count * 2, max_invocation_count);
-                    }
-                    else
-                    {
-                        loop *= 2;
-                    }
-                    rerun = true;
-                    break;
-                }
-
-                double gflops;
-                {
-                    double mac = (double)invocation_count * ((double)loop * 16 * 2);
-
-                    if (packing_type == 256)
-                    {
-                        mac *= M * N * K;
-                        mac /= local_size_x;
-                    }
-                    else
-                    {
-                        mac *= packing_type;
-                    }
-
-                    gflops = mac / time / 1000000;
-                }
-                double gflops_dual;
-                {
-                    // dual issue is faster
-                    double mac = (double)invocation_count * ((double)loop * 16 * 2 + 1); // +1 for the tail c0+c1
-
-                    if (packing_type == 256)
-                    {
-                        mac *= M * N * K;
-                        mac /= local_size_x;
-                    }
-                    else
-                    {
-                        mac *= packing_type;
-                    }
-
-                    gflops_dual = mac / time_dual / 1000000;
-                }
-
-                gflops = std::max(gflops, gflops_dual);
-
-                // fprintf(stderr, "%f gflops\n", gflops);
-
-                if (gflops > max_gflops)
-                    max_gflops = gflops;
-            }
-        }
-    }
-
-    vkdev->reclaim_blob_allocator(allocator);
-
-    return max_gflops;
+    return (jfloat)gops;
 }
 
-extern "C" {
-
-JNIEXPORT jint JNI_OnLoad(JavaVM* vm, void* reserved)
+// public native float RunSfu(int loop, int count_mb, int cmd_loop, int arithmetic_type, int packing_type, int func_type);
+JNIEXPORT jfloat JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_RunSfu(JNIEnv* env, jobject thiz, jint loop, jint count_mb, jint cmd_loop, jint arithmetic_type, jint packing_type, jint func_type)
 {
-    __android_log_print(ANDROID_LOG_DEBUG, "VkPeakNcnn", "JNI_OnLoad");
+    vkpeak_set_device_index(g_device_index);
 
-    ncnn::create_gpu_instance();
+    double gops = vkpeak_sfu(loop, count_mb, cmd_loop, arithmetic_type, packing_type, func_type);
 
-    return JNI_VERSION_1_4;
+    return (jfloat)gops;
 }
 
-JNIEXPORT void JNI_OnUnload(JavaVM* vm, void* reserved)
+// public native float RunLatency(int loop, int cmd_loop, int footprint_kb, int walker_type);
+JNIEXPORT jfloat JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_RunLatency(JNIEnv* env, jobject thiz, jint loop, jint cmd_loop, jint footprint_kb, jint walker_type)
 {
-    __android_log_print(ANDROID_LOG_DEBUG, "VkPeakNcnn", "JNI_OnUnload");
+    vkpeak_set_device_index(g_device_index);
 
-    ncnn::destroy_gpu_instance();
+    double ns = vkpeak_latency(loop, cmd_loop, footprint_kb, walker_type);
+
+    return (jfloat)ns;
 }
 
-// public native String GetPlatform();
-JNIEXPORT jstring JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_GetPlatform(JNIEnv* env, jobject thiz)
+// public native float RunCpu(int loop, int cmd_loop, int thread_count, int arithmetic_type, int packing_type);
+JNIEXPORT jfloat JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_RunCpu(JNIEnv* env, jobject thiz, jint loop, jint cmd_loop, jint thread_count, jint arithmetic_type, jint packing_type)
 {
-    char platform[PROP_VALUE_MAX+1];
-    __system_property_get("ro.board.platform", platform);
+    double gflops = vkpeak_cpu(loop, cmd_loop, thread_count, arithmetic_type, packing_type);
 
-    return env->NewStringUTF(platform);
+    return (jfloat)gflops;
 }
 
-// public native String GetNcnnVersion();
-JNIEXPORT jstring JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_GetNcnnVersion(JNIEnv* env, jobject thiz)
+// public native String GetCpuKernelName(int arithmetic_type, int packing_type);
+JNIEXPORT jstring JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_GetCpuKernelName(JNIEnv* env, jobject thiz, jint arithmetic_type, jint packing_type)
 {
-    return env->NewStringUTF(NCNN_VERSION_STRING);
+    return env->NewStringUTF(vkpeak_cpu_kernel_name(arithmetic_type, packing_type));
 }
 
-// public native String GetVkDevice();
-JNIEXPORT jstring JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_GetVkDevice(JNIEnv* env, jobject thiz)
+// public native int GetCpuClusterCount();
+JNIEXPORT jint JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_GetCpuClusterCount(JNIEnv* env, jobject thiz)
 {
-    ncnn::VulkanDevice* vkdev = ncnn::get_gpu_device();
-    if (!vkdev)
-    {
-        return env->NewStringUTF("No vulkan device");
-    }
-
-    return env->NewStringUTF(vkdev->info.device_name());
+    return vkpeak_cpu_cluster_count();
 }
 
-// public native String GetApiVersion();
-JNIEXPORT jstring JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_GetApiVersion(JNIEnv* env, jobject thiz)
+// public native int GetCpuClusterCoreCount(int cluster_index);
+JNIEXPORT jint JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_GetCpuClusterCoreCount(JNIEnv* env, jobject thiz, jint cluster_index)
 {
-    ncnn::VulkanDevice* vkdev = ncnn::get_gpu_device();
-    if (!vkdev)
-    {
-        return env->NewStringUTF("No vulkan device");
-    }
-
-    uint32_t api_version = vkdev->info.api_version();
-
-    char tmp[128];
-    sprintf(tmp, "%u.%u.%u", VK_VERSION_MAJOR(api_version), VK_VERSION_MINOR(api_version), VK_VERSION_PATCH(api_version));
-
-    return env->NewStringUTF(tmp);
+    return vkpeak_cpu_cluster_core_count(cluster_index);
 }
 
-// public native String GetDriverVersion();
-JNIEXPORT jstring JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_GetDriverVersion(JNIEnv* env, jobject thiz)
+// public native int GetCpuClusterMaxFreq(int cluster_index);
+JNIEXPORT jint JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_GetCpuClusterMaxFreq(JNIEnv* env, jobject thiz, jint cluster_index)
 {
-    ncnn::VulkanDevice* vkdev = ncnn::get_gpu_device();
-    if (!vkdev)
-    {
-        return env->NewStringUTF("No vulkan device");
-    }
-
-    uint32_t driver_version = vkdev->info.driver_version();
-
-    char tmp[128];
-    sprintf(tmp, "%u.%u.%u", VK_VERSION_MAJOR(driver_version), VK_VERSION_MINOR(driver_version), VK_VERSION_PATCH(driver_version));
-
-    return env->NewStringUTF(tmp);
+    return vkpeak_cpu_cluster_max_freq(cluster_index);
 }
 
-// public native float Run(int loop, int count_mb, int cmd_loop, int storage_type, int arithmetic_type, int packing_type);
-JNIEXPORT jfloat JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_Run(JNIEnv* env, jobject thiz, jint loop, jint count_mb, jint cmd_loop, jint storage_type, jint arithmetic_type, jint packing_type)
+// public native float RunCpuCluster(int loop, int cmd_loop, int cluster_index, int thread_count, int arithmetic_type, int packing_type);
+JNIEXPORT jfloat JNICALL Java_com_tencent_vkpeakncnn_VkPeakNcnn_RunCpuCluster(JNIEnv* env, jobject thiz, jint loop, jint cmd_loop, jint cluster_index, jint thread_count, jint arithmetic_type, jint packing_type)
 {
-    double gflops = vkpeak(loop, count_mb, cmd_loop, storage_type, arithmetic_type, packing_type);
+    double gflops = vkpeak_cpu_cluster(loop, cmd_loop, cluster_index, thread_count, arithmetic_type, packing_type);
 
     return (jfloat)gflops;
 }